@@ -0,0 +1,104 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Plotter.hpp"
+
+// Measures how rendering scales with threads: every thread constructs and renders its own
+// Plotters over shared data, from 1 up to 64 threads at once. The throughput of each thread
+// count is compared with a single thread for both cell engines, so contention on shared state,
+// such as the allocator or the global locale of the Stream engine, shows as lost speedup.
+// Usage: plotter_scaling_benchmark [tables per thread] [max threads]
+
+namespace {
+
+    constexpr std::size_t scaling_columns = 6;
+    constexpr std::size_t scaling_rows = 200;
+
+    /**
+     * @brief Result of one thread count.
+     */
+    struct ScalingResult {
+        double seconds;
+        std::size_t bytes;
+    };
+
+    /**
+     * @brief Runs thread_count threads which all start together and each render tables_per_thread tables.
+     */
+    ScalingResult run_threads(std::vector<double>& data, const std::vector<std::string>& column_names, unsigned int thread_count,
+        std::size_t tables_per_thread, CellEngine engine) {
+        std::atomic<unsigned int> ready{ 0 };
+        std::atomic<bool> start{ false };
+        std::atomic<std::size_t> bytes{ 0 };
+        std::vector<std::thread> threads;
+
+        for (unsigned int t = 0; t < thread_count; t++) {
+            threads.emplace_back([&, t] {
+                ready.fetch_add(1);
+                while (!start.load(std::memory_order_acquire)) {
+                    std::this_thread::yield();
+                }
+                std::size_t written = 0;
+                for (std::size_t i = 0; i < tables_per_thread; i++) {
+                    // a fresh Plotter per table, construction is part of the measured work
+                    Plotter<double> plotter(data.data(), "thread " + std::to_string(t), column_names, 96, data.size(), DataArrangement::RowMajor);
+                    written += plotter.get_table({ .engine = engine }).size();
+                }
+                bytes.fetch_add(written);
+            });
+        }
+
+        while (ready.load() != thread_count) {
+            std::this_thread::yield();
+        }
+        auto begin = std::chrono::steady_clock::now();
+        start.store(true, std::memory_order_release);
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+        return { elapsed.count(), bytes.load() };
+    }
+}
+
+int main(int argc, char** argv) {
+    std::size_t tables_per_thread = argc > 1 ? std::stoull(argv[1]) : 50;
+    unsigned int max_threads = argc > 2 ? static_cast<unsigned int>(std::stoul(argv[2])) : 64;
+
+    std::vector<double> data(scaling_columns * scaling_rows);
+    for (std::size_t i = 0; i < data.size(); i++) {
+        data[i] = static_cast<double>(i % 1013) * 1.25 - 400.0;
+    }
+    std::vector<std::string> column_names;
+    for (std::size_t j = 0; j < scaling_columns; j++) {
+        column_names.push_back("column " + std::to_string(j));
+    }
+
+    std::cout << "hardware threads: " << std::thread::hardware_concurrency() << ", tables per thread: " << tables_per_thread << "\n";
+    std::cout << std::left << std::setw(9) << "engine" << std::right << std::setw(8) << "threads" << std::setw(12) << "tables/s"
+        << std::setw(10) << "MB/s" << std::setw(10) << "speedup" << std::setw(12) << "efficiency" << "\n";
+
+    for (CellEngine engine : { CellEngine::ToChars, CellEngine::Stream }) {
+        const char* engine_name = engine == CellEngine::ToChars ? "ToChars" : "Stream";
+        double single_rate = 0.0;
+        for (unsigned int thread_count = 1; thread_count <= max_threads; thread_count *= 2) {
+            ScalingResult result = run_threads(data, column_names, thread_count, tables_per_thread, engine);
+            double rate = static_cast<double>(thread_count * tables_per_thread) / result.seconds;
+            if (thread_count == 1) {
+                single_rate = rate;
+            }
+            double speedup = rate / single_rate;
+            double ideal = std::min<double>(thread_count, std::max(1u, std::thread::hardware_concurrency()));
+            std::cout << std::left << std::setw(9) << engine_name << std::right << std::setw(8) << thread_count << std::fixed << std::setprecision(1)
+                << std::setw(12) << rate << std::setw(10) << static_cast<double>(result.bytes) / result.seconds / 1e6
+                << std::setprecision(2) << std::setw(10) << speedup << std::setw(12) << speedup / ideal << "\n";
+        }
+    }
+    return EXIT_SUCCESS;
+}
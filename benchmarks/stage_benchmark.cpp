@@ -0,0 +1,218 @@
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <new>
+#include <string>
+#include <vector>
+#include "Plotter.hpp"
+
+// Times the stages of a render one by one: the table header, the columns header, the endline,
+// the fit check of rendered_size, the formatting of a single cell and the report of a value
+// which overflows its cell. Every stage runs many times on a table of each type at several widths
+// and is reported in nanoseconds and heap allocations per cell.
+// Usage: plotter_stage_benchmark [iterations]
+
+namespace {
+
+    std::atomic<std::size_t> allocation_count{ 0 };
+}
+
+void* operator new(std::size_t size) {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if (void* memory = std::malloc(size == 0 ? 1 : size)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+/**
+ * @brief Calls the private render stages of a Plotter for the benchmark.
+ */
+template <typename T>
+struct plotter_detail::StageAccess {
+
+    using State = typename Plotter<T>::RenderState;
+
+    static constexpr std::size_t cell_buffer_size = Plotter<T>::cell_buffer_size;
+
+    static State make_state(const Plotter<T>& plotter, TableWriter table) {
+        State state = plotter.make_render_state({}, table);
+        plotter.select_page(state, 0);
+        return state;
+    }
+
+    static void table_header(const Plotter<T>& plotter, State& state) {
+        plotter.print_table_header(state);
+    }
+
+    static void columns_header(const Plotter<T>& plotter, State& state) {
+        plotter.print_columns_header(state);
+    }
+
+    static void endline(const Plotter<T>& plotter, State& state) {
+        plotter.print_endline(state);
+    }
+
+    static std::size_t fit_check(const Plotter<T>& plotter, const State& state) {
+        return plotter.content_size(state);
+    }
+
+    static std::string_view format_cell(const Plotter<T>& plotter, const T& value, std::span<char> buffer) {
+        return plotter.format_cell(value, buffer);
+    }
+
+    static void overflow(const Plotter<T>& plotter, State& state, std::pmr::string& out, const T& value) {
+        plotter.append_overflow(state, out, 0, value);
+    }
+
+    static std::size_t column_width(const State& state) {
+        return state.column_width;
+    }
+};
+
+namespace {
+
+    constexpr std::size_t benchmark_columns = 8;
+    constexpr std::size_t benchmark_rows = 64;
+    const std::size_t benchmark_widths[] = { 40, 80, 160, 320 };
+
+    /**
+     * @brief Result of one stage, per cell.
+     */
+    struct StageResult {
+        double nanoseconds;
+        double allocations;
+    };
+
+    /**
+     * @brief Runs the stage iterations times and divides its time and allocations by the cells it handled.
+     */
+    template <typename Function>
+    StageResult measure(std::size_t iterations, std::size_t cells_per_call, Function&& stage) {
+        // one untimed call warms up the caches and the lazily allocated buffers
+        stage();
+        std::size_t allocations = allocation_count.load(std::memory_order_relaxed);
+        auto start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < iterations; i++) {
+            stage();
+        }
+        std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        double cells = static_cast<double>(iterations * cells_per_call);
+        return { elapsed.count() / cells, static_cast<double>(allocation_count.load(std::memory_order_relaxed) - allocations) / cells };
+    }
+
+    /**
+     * @brief Returns the i-th value of the benchmark table, long values overflow narrow cells.
+     */
+    template <typename T>
+    T make_value(std::size_t i, bool overflowing) {
+        if constexpr (std::is_floating_point_v<T>) {
+            return static_cast<T>(overflowing ? 123456789.0 * static_cast<double>(i + 1) : static_cast<double>(i % 97) / 8.0);
+        }
+        else if constexpr (std::is_integral_v<T>) {
+            return static_cast<T>(overflowing ? std::numeric_limits<T>::max() - static_cast<T>(i) : static_cast<T>(i % 97));
+        }
+        else {
+            return overflowing ? T("a value which overflows every cell " + std::to_string(i)) : T(std::to_string(i % 97));
+        }
+    }
+
+    void print_result(const char* type_name, std::size_t width, std::size_t column_width, const char* stage, StageResult result) {
+        std::cout << std::left << std::setw(20) << type_name << std::right << std::setw(6) << width << std::setw(7) << column_width
+            << "  " << std::left << std::setw(16) << stage << std::right << std::fixed << std::setprecision(2)
+            << std::setw(10) << result.nanoseconds << std::setw(12) << result.allocations << "\n";
+    }
+
+    template <typename T>
+    void benchmark_type(const char* type_name, std::size_t iterations) {
+        using Access = plotter_detail::StageAccess<T>;
+
+        std::vector<T> data;
+        std::vector<T> overflowing;
+        for (std::size_t i = 0; i < benchmark_columns * benchmark_rows; i++) {
+            data.push_back(make_value<T>(i, false));
+            overflowing.push_back(make_value<T>(i, true));
+        }
+        std::vector<std::string> column_names;
+        for (std::size_t j = 0; j < benchmark_columns; j++) {
+            column_names.push_back("c" + std::to_string(j));
+        }
+
+        std::vector<char> output(1 << 20);
+        for (std::size_t width : benchmark_widths) {
+            Plotter<T> plotter(data.data(), "stages", column_names, width, data.size(), DataArrangement::RowMajor);
+            Plotter<T> overflowing_plotter(overflowing.data(), "stages", column_names, width, overflowing.size(), DataArrangement::RowMajor);
+            auto state = Access::make_state(plotter, TableWriter(std::span<char>(output)));
+            auto overflowing_state = Access::make_state(overflowing_plotter, TableWriter(std::span<char>(output)));
+            std::size_t column_width = Access::column_width(state);
+            std::array<char, Access::cell_buffer_size> buffer;
+            std::pmr::string overflow_text;
+            std::size_t sink = 0;
+
+            // the writer restarts at the beginning of the output for every call
+            auto restart = [&](auto& stage_state) {
+                stage_state.table = TableWriter(std::span<char>(output));
+            };
+
+            print_result(type_name, width, column_width, "table header", measure(iterations, benchmark_columns, [&] {
+                restart(state);
+                Access::table_header(plotter, state);
+            }));
+            print_result(type_name, width, column_width, "columns header", measure(iterations, benchmark_columns, [&] {
+                restart(state);
+                Access::columns_header(plotter, state);
+            }));
+            print_result(type_name, width, column_width, "endline", measure(iterations, benchmark_columns, [&] {
+                restart(state);
+                Access::endline(plotter, state);
+            }));
+            print_result(type_name, width, column_width, "fit check", measure(iterations / benchmark_rows + 1, data.size(), [&] {
+                sink += Access::fit_check(plotter, state);
+            }));
+            print_result(type_name, width, column_width, "format cell", measure(iterations, data.size(), [&] {
+                for (const T& value : data) {
+                    sink += Access::format_cell(plotter, value, buffer).size();
+                }
+            }));
+            print_result(type_name, width, column_width, "overflow", measure(iterations, overflowing.size(), [&] {
+                overflow_text.clear();
+                for (const T& value : overflowing) {
+                    Access::overflow(overflowing_plotter, overflowing_state, overflow_text, value);
+                }
+            }));
+
+            // keeps the results of the pure stages alive
+            if (sink == static_cast<std::size_t>(-1)) {
+                std::cout << sink;
+            }
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    std::size_t iterations = argc > 1 ? std::stoull(argv[1]) : 2000;
+
+    std::cout << std::left << std::setw(20) << "type" << std::right << std::setw(6) << "width" << std::setw(7) << "cell"
+        << "  " << std::left << std::setw(16) << "stage" << std::right << std::setw(10) << "ns/cell" << std::setw(12) << "allocs/cell" << "\n";
+    benchmark_type<int>("int", iterations);
+    benchmark_type<long long>("long long", iterations);
+    benchmark_type<unsigned long long>("unsigned long long", iterations);
+    benchmark_type<double>("double", iterations);
+    benchmark_type<float>("float", iterations);
+    benchmark_type<long double>("long double", iterations);
+    benchmark_type<std::string>("string", iterations);
+    return EXIT_SUCCESS;
+}
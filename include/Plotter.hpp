@@ -1,49 +1,585 @@
 #pragma once
 #include <iostream>
-#include <iomanip>
 #include <vector>
-#include <sstream>
+#include <span>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <optional>
+#include <array>
+#include <chrono>
+#include <charconv>
+#include <concepts>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+
+// Render statistics are collected only when PLOTTER_ENABLE_STATS is 1,
+// otherwise the counters compile to nothing and RenderStats stays zero.
+#ifndef PLOTTER_ENABLE_STATS
+#define PLOTTER_ENABLE_STATS 0
+#endif
 
 enum class DataArrangement {
     ColumnMajor,
     RowMajor
 };
 
+enum class HeatmapPalette {
+    Ansi256,
+    TrueColor
+};
+
+/**
+ * @brief Engine which turns the values of the cells into text.
+ * 
+ * ToChars formats numbers by std::to_chars and is used by default. Stream formats every value
+ * by a std::ostringstream with std::fixed and the precision of the table, the way the original
+ * stream based implementation did. It is much slower and serves as the reference the output
+ * of ToChars is verified against.
+ */
+enum class CellEngine {
+    ToChars,
+    Stream
+};
+
+/**
+ * @brief Characters which localize the numbers in the cells.
+ * 
+ * The decimal point replaces the '.' of floating point values, a non-zero thousands separator
+ * is inserted between groups of three integer digits. Characters and bool are not numbers here.
+ */
+struct NumberFormat {
+    char decimal_point = '.';
+    char thousands_separator = '\0';
+};
+
+/**
+ * @brief Monotonic memory arena for the transient allocations of a render.
+ * 
+ * Allocations are served from a single buffer and freed all at once by reset().
+ * When a render needs more memory than the buffer holds, the buffer is enlarged
+ * to the high-water mark on the next reset, so repeated renders of similar tables
+ * stop allocating from the upstream resource.
+ */
+class RenderArena : public std::pmr::memory_resource {
+
+    std::pmr::memory_resource* _upstream;
+    std::pmr::vector<std::byte> _buffer;
+    std::optional<std::pmr::monotonic_buffer_resource> _resource;
+    std::size_t _allocated;
+
+protected:
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+public:
+
+    explicit RenderArena(std::size_t initial_size = 64 * 1024, std::pmr::memory_resource* upstream = std::pmr::get_default_resource());
+
+    RenderArena(const RenderArena&) = delete;
+    RenderArena& operator=(const RenderArena&) = delete;
+
+    void reset();
+};
+
+/**
+ * @brief Output of a render, either a growable string or a fixed caller-provided buffer.
+ * 
+ * Text is appended at the cursor. A growable writer enlarges its string geometrically,
+ * a fixed writer throws when the buffer is full, renders into fixed buffers are sized
+ * by Plotter::rendered_size beforehand, so this does not happen.
+ */
+class TableWriter {
+
+    std::string* _string;
+    char* _begin;
+    char* _cursor;
+    char* _end;
+    std::size_t _allocations;
+
+    void grow(std::size_t count);
+
+public:
+
+    TableWriter();
+    explicit TableWriter(std::string& string);
+    explicit TableWriter(std::span<char> buffer);
+
+    /**
+     * @brief Claims count bytes at the cursor and returns their address.
+     */
+    char* claim(std::size_t count) {
+        if (count > static_cast<std::size_t>(_end - _cursor)) {
+            grow(count);
+        }
+        char* claimed = _cursor;
+        _cursor += count;
+        return claimed;
+    }
+
+    char* append(std::string_view text) {
+        char* written = claim(text.size());
+        std::char_traits<char>::copy(written, text.data(), text.size());
+        return written;
+    }
+
+    void append(std::size_t count, char character) {
+        std::char_traits<char>::assign(claim(count), count, character);
+    }
+
+    TableWriter& operator+=(std::string_view text) {
+        append(text);
+        return *this;
+    }
+
+    TableWriter& operator+=(char character) {
+        *claim(1) = character;
+        return *this;
+    }
+
+    void pop_back() {
+        _cursor--;
+    }
+
+    /**
+     * @brief Returns the start of the written text, it moves when the string grows.
+     */
+    char* data() const {
+        return _begin;
+    }
+
+    std::size_t size() const {
+        return static_cast<std::size_t>(_cursor - _begin);
+    }
+
+    std::size_t finish();
+
+    /**
+     * @brief Returns the number of times growing the string reallocated it.
+     */
+    std::size_t allocations() const {
+        return _allocations;
+    }
+};
+
+/**
+ * @brief Result of Plotter::render_into.
+ * 
+ * The table is written only when it fits the destination. Otherwise nothing is written
+ * and required tells how large the destination has to be.
+ */
+struct RenderResult {
+    std::size_t written;
+    std::size_t required;
+
+    bool fits() const {
+        return written == required;
+    }
+};
+
+/**
+ * @brief Progress of a table which is rendered while its data grows, see Plotter::get_new_rows.
+ * 
+ * It remembers whether the headers were written and how many rows were emitted,
+ * a cursor belongs to one output of one table.
+ */
+struct AppendCursor {
+    std::size_t emitted_rows = 0;
+    bool header_emitted = false;
+    bool finalized = false;
+};
+
+/**
+ * @brief Metrics of renders, filled when RenderOptions::stats points to it.
+ * 
+ * The counters are added to, so one object can sum up any number of renders.
+ * Formatting time covers the rows or heatmap cells, framing time the headers and closing lines,
+ * sink time the writes to the output stream. Overflow time is the part of the formatting time
+ * spent reporting values which are too long for their cell. Allocations count the requests to
+ * the memory resource of the render and the reallocations of the output string.
+ * Cache lookups and hits count the cells looked up in the value cache of RenderOptions::value_cache.
+ * Nothing is collected unless the library is built with PLOTTER_ENABLE_STATS.
+ */
+struct RenderStats {
+    std::size_t cells_formatted = 0;
+    std::size_t overflow_cells = 0;
+    std::size_t bytes_emitted = 0;
+    std::size_t allocations = 0;
+    std::chrono::nanoseconds format_time{ 0 };
+    std::chrono::nanoseconds overflow_time{ 0 };
+    std::chrono::nanoseconds frame_time{ 0 };
+    std::chrono::nanoseconds sink_time{ 0 };
+    std::size_t cache_lookups = 0;
+    std::size_t cache_hits = 0;
+
+    RenderStats& operator+=(const RenderStats& other);
+
+    /**
+     * @brief Returns the formatting time per cell in nanoseconds, overflow cells excluded.
+     */
+    double format_ns_per_cell() const {
+        std::size_t cells = cells_formatted - overflow_cells;
+        return cells != 0 ? static_cast<double>((format_time - overflow_time).count()) / static_cast<double>(cells) : 0.0;
+    }
+
+    /**
+     * @brief Returns the time per overflow cell in nanoseconds.
+     */
+    double overflow_ns_per_cell() const {
+        return overflow_cells != 0 ? static_cast<double>(overflow_time.count()) / static_cast<double>(overflow_cells) : 0.0;
+    }
+
+    /**
+     * @brief Returns the allocations per formatted cell.
+     */
+    double allocations_per_cell() const {
+        return cells_formatted != 0 ? static_cast<double>(allocations) / static_cast<double>(cells_formatted) : 0.0;
+    }
+
+    /**
+     * @brief Returns the share of value cache lookups which found the formatted value.
+     */
+    double cache_hit_rate() const {
+        return cache_lookups != 0 ? static_cast<double>(cache_hits) / static_cast<double>(cache_lookups) : 0.0;
+    }
+};
+
+/**
+ * @brief Recorder of render phases in the Chrome trace event format.
+ * 
+ * Renders given the recorder through RenderOptions::trace or Plotter::render_all add one
+ * complete event per phase: the table header, the columns header, every rendered chunk of rows
+ * and every write to the sink. write_json() produces a file which chrome://tracing and
+ * Perfetto open directly. Events are coarse, so the recorder is shared by all threads
+ * behind a mutex, a render without a recorder only checks a null pointer.
+ */
+class RenderTrace {
+
+    struct Event {
+        const char* name;
+        std::chrono::steady_clock::time_point start;
+        std::chrono::steady_clock::duration duration;
+        std::size_t thread;
+        std::size_t first;
+        std::size_t count;
+    };
+
+    std::chrono::steady_clock::time_point _origin;
+    mutable std::mutex _mutex;
+    std::vector<Event> _events;
+    std::vector<std::thread::id> _threads;
+
+public:
+
+    // marks events which do not cover a range of rows or tables
+    static constexpr std::size_t no_range = static_cast<std::size_t>(-1);
+
+    RenderTrace();
+
+    RenderTrace(const RenderTrace&) = delete;
+    RenderTrace& operator=(const RenderTrace&) = delete;
+
+    void record(const char* name, std::chrono::steady_clock::time_point start, std::size_t first = no_range, std::size_t count = 0);
+    void write_json(std::ostream& out) const;
+    std::size_t size() const;
+    void clear();
+};
+
+/**
+ * @brief Per-call options of a render.
+ * 
+ * Rows outside the window [first_row, first_row + row_count) are skipped,
+ * the window is clipped to the rows of the table.
+ * A memory_resource set here replaces the one configured by Plotter::set_memory_resource
+ * for this call, which is how concurrent renders of one Plotter get separate arenas.
+ * The metrics of the render are added to stats when it is set, its phases are recorded by trace.
+ * A non-zero paged_column_width splits columns which would be narrower into pages, every page
+ * is rendered as a table of its own below the previous one.
+ * With wrap_cells, string cells longer than their column are wrapped at whitespace into
+ * several lines instead of being reported after the row.
+ * With value_cache, every column of numbers keeps a small cache of its recently formatted values,
+ * so repeated values are copied instead of formatted again. A column whose hit rate stays low
+ * turns its cache off during the render.
+ */
+struct RenderOptions {
+    std::size_t first_row = 0;
+    std::size_t row_count = static_cast<std::size_t>(-1);
+    std::pmr::memory_resource* memory_resource = nullptr;
+    RenderStats* stats = nullptr;
+    RenderTrace* trace = nullptr;
+    CellEngine engine = CellEngine::ToChars;
+    std::size_t paged_column_width = 0;
+    bool wrap_cells = false;
+    bool value_cache = false;
+};
+
+/**
+ * @brief Rows shown by Plotter::get_diff.
+ * 
+ * ChangedRows shows only the rows with a changed cell, every run of them is introduced
+ * by the index of its first row. AllRows shows every row of the render window.
+ */
+enum class DiffMode {
+    ChangedRows,
+    AllRows
+};
+
+/**
+ * @brief Options of a diff between two tables of the same shape.
+ * 
+ * Floating point cells are unchanged while they differ by at most epsilon,
+ * other cells while they compare equal. Changed cells are marked by '*' in place of
+ * the separator on their left.
+ */
+struct DiffOptions {
+    DiffMode mode = DiffMode::ChangedRows;
+    double epsilon = 0.0;
+};
+
+/**
+ * @brief Customization point for showing user types in table cells.
+ * 
+ * Specialize it for a type to make the type usable with Plotter. The format function works
+ * like std::to_chars, it writes the text into [first, last) and returns the end of the text,
+ * or std::errc::value_too_large when the range is too small.
+ * 
+ * @code
+ * template <>
+ * struct CellFormatter<Money> {
+ *     static std::to_chars_result format(char* first, char* last, const Money& value);
+ * };
+ * @endcode
+ */
+template <typename T>
+struct CellFormatter;
+
+template <typename T>
+concept CustomCellFormattable = requires(char* first, char* last, const T& value) {
+    { CellFormatter<T>::format(first, last, value) } -> std::same_as<std::to_chars_result>;
+};
+
+template <typename T>
+concept CellText = std::is_convertible_v<const T&, std::string_view> && !std::is_pointer_v<T>;
+
+/**
+ * @brief Types Plotter can show: arithmetic types, string-like types and types with a CellFormatter.
+ */
 template <typename T>
+concept Plottable = (std::is_arithmetic_v<T> || CellText<T> || CustomCellFormattable<T>) && std::default_initializable<T> && std::copy_constructible<T>;
+
+/**
+ * @brief Description of one table rendered by Plotter::render_all.
+ * 
+ * The fields mirror the arguments of the Plotter constructor.
+ */
+template <Plottable T>
+struct TableSpec {
+    T* data;
+    std::string name;
+    std::vector<std::string> column_names;
+    std::size_t table_width;
+    std::size_t size;
+    DataArrangement data_arrangement;
+};
+
+namespace plotter_detail {
+    class CountingResource;
+
+    // longest text kept by the value cache, longer values are formatted every time
+    constexpr std::size_t value_cache_text_size = 31;
+
+    /**
+     * @brief Slot of the value cache, a zero length marks an empty slot.
+     */
+    template <typename T>
+    struct CachedValue {
+        T value;
+        std::uint8_t length;
+        std::array<char, value_cache_text_size> text;
+    };
+
+    /**
+     * @brief Hit counters of the value cache of one column.
+     */
+    struct ValueCacheColumn {
+        std::size_t lookups;
+        std::size_t hits;
+        bool enabled;
+    };
+
+    /**
+     * @brief Access to the render stages of a Plotter, defined only by the stage benchmark.
+     */
+    template <typename T>
+    struct StageAccess;
+}
+
+std::size_t terminal_width(std::size_t fallback = 80);
+
+template <Plottable T>
 class Plotter {
 
-    std::stringstream _table;
-    
+    friend struct plotter_detail::StageAccess<T>;
+
+    /**
+     * @brief State of a single render, owned by the rendering call.
+     */
+    struct RenderState {
+        TableWriter table;
+        std::pmr::memory_resource* memory_resource;
+        const T* data;
+        std::size_t first_row;
+        std::size_t last_row;
+        std::size_t first_column;
+        std::size_t column_count;
+        std::size_t column_width;
+        std::size_t page_columns;
+        std::size_t frame_width;
+        bool wrap_cells;
+        bool value_cache;
+        RenderStats* stats;
+        RenderTrace* trace;
+        CellEngine engine;
+        std::unique_ptr<plotter_detail::CountingResource> counting_resource;
+        std::pmr::string row_template;
+        std::pmr::string default_cell;
+        std::pmr::vector<std::string_view> wrapped_lines;
+        std::pmr::vector<std::size_t> wrapped_cells;
+        std::pmr::vector<plotter_detail::CachedValue<T>> cached_values;
+        std::pmr::vector<plotter_detail::ValueCacheColumn> cache_columns;
+        std::pmr::string padded_entries;
+        std::pmr::vector<char> long_entries;
+        std::pmr::vector<std::size_t> cell_separators;
+        const unsigned char* changed_cells;
+        DiffMode diff_mode;
+    };
+
+    // capacity of the buffer a single cell is formatted into
+    static constexpr std::size_t cell_buffer_size = 512;
+
     T* _data;
 
+    // dictionary-encoded data, the codes are null unless the table was constructed from them
+    const std::uint32_t* _codes;
+    std::vector<T> _dictionary;
+
     DataArrangement _data_arrangement;
 
     std::vector<std::string> _column_names;
 
     std::string _name;
 
-    unsigned int _table_width;
-    unsigned int _column_width;
-    unsigned int _size;
-    unsigned int _cols;
-    unsigned int _rows;
+    std::size_t _table_width;
+    // the width was taken from the terminal, columns which do not fit are hidden
+    bool _auto_width;
+    std::size_t _column_width;
+    std::size_t _size;
+    std::size_t _cols;
+    std::size_t _shown_cols;
+    std::size_t _rows;
+    std::size_t _full_rows;
     unsigned int _precision;
+    NumberFormat _number_format;
+    bool _localized;
+
+    std::pmr::memory_resource* _memory_resource;
 
-    void print_content();
-    void print_row(unsigned int start_index, unsigned int count, int stride);
-    void print_columns_header();
-    void print_table_header();
-    void print_endline();
+    // priority of every column, the shown columns in data order and the offsets of their cells in a row
+    std::vector<unsigned int> _column_priorities;
+    std::size_t _min_column_width;
+    std::vector<std::size_t> _shown_columns;
+    std::vector<std::size_t> _cell_offsets;
+
+    void render(RenderState& state) const;
+    void print_content(RenderState& state) const;
+    void print_rows(RenderState& state) const;
+    void print_row(RenderState& state, std::size_t start_index, std::size_t count) const;
+    void print_wrapped_row(RenderState& state, std::size_t start_index, std::size_t count) const;
+    void print_dictionary_row(RenderState& state, std::size_t start_index, std::size_t count) const;
+    void print_diff_rows(RenderState& state) const;
+    std::string render_appended(AppendCursor& cursor, const RenderOptions& options, bool final) const;
+    void pad_dictionary(RenderState& state) const;
+    void append_overflow(RenderState& state, std::pmr::string& out, std::size_t column, const T& value) const;
+    void print_columns_header(RenderState& state) const;
+    void print_table_header(RenderState& state) const;
+    void print_endline(RenderState& state) const;
+    void print_repeated(RenderState& state, char character, std::ptrdiff_t count) const;
+    void initialize();
+    void assign(const TableSpec<T>& spec);
     void validate_inputs_throw_exception();
+    void print_heatmap_content(RenderState& state, HeatmapPalette palette) const;
+    RenderState make_render_state(const RenderOptions& options, TableWriter table = TableWriter()) const;
+    void append_table(std::string& out, const RenderOptions& options) const;
+    std::size_t frame_size(const RenderState& state) const;
+    std::size_t header_size(std::size_t column_count, std::size_t column_width, std::size_t frame_width) const;
+    std::size_t row_size(std::size_t column_count, std::size_t column_width) const;
+    std::size_t page_width(std::size_t page_columns, std::size_t column_count, std::size_t column_width) const;
+    void validate_layout_throw_exception(const RenderState& state) const;
+    void select_page(RenderState& state, std::size_t first_column) const;
+    void release_transient_memory(RenderState& state) const;
 
-    int calculate_column_width(int table_width, int cols);
-    int calculate_rows(int size, int column_count);
-    bool col_width_is_sufficient(T value, unsigned int column_width);
+    std::size_t calculate_column_width(std::size_t table_width, std::size_t cols) const;
+    std::size_t calculate_rows(std::size_t size, std::size_t column_count);
+    std::size_t calculate_full_rows() const;
+    std::size_t row_cell_count(std::size_t row) const;
+    std::size_t row_start_index(std::size_t row) const;
+    std::size_t shown_cell_count(std::size_t row) const;
+    std::size_t page_cell_count(const RenderState& state, std::size_t row) const;
+    const T& value_at(const RenderState& state, std::size_t index) const;
+    void update_layout();
+    std::string_view format_cell(const T& value, std::span<char> buffer, CellEngine engine = CellEngine::ToChars) const;
+    std::string_view format_cached(RenderState& state, std::size_t column, const T& value, std::span<char> buffer) const;
+    std::string_view format_plain(const T& value, std::span<char> buffer, CellEngine engine = CellEngine::ToChars) const;
+    std::string_view format_stream(const T& value, std::span<char> buffer, bool fixed) const;
+    std::string_view localize(std::string_view text, std::span<char> buffer) const;
+    std::size_t content_size(const RenderState& state) const;
 
 public:
         
-    Plotter(T* data, std::string name, std::vector<std::string> column_names, unsigned int table_width, unsigned int size, DataArrangement data_arrangement);
+    Plotter(T* data, std::string name, std::vector<std::string> column_names, std::size_t table_width, std::size_t size, DataArrangement data_arrangement);
+    Plotter(const std::uint32_t* codes, std::vector<T> dictionary, std::string name, std::vector<std::string> column_names, std::size_t table_width, std::size_t size, DataArrangement data_arrangement) requires CellText<T>;
+
+    void print_table() const;
+    void print_table(std::ostream& sink, const RenderOptions& options = {}) const;
+    std::string get_table(const RenderOptions& options = {}) const;
+    std::size_t rendered_size(const RenderOptions& options = {}) const;
+    RenderResult render_into(std::span<char> destination, const RenderOptions& options = {}) const;
+    void write_file(const std::string& path, unsigned int threads = 0, const RenderOptions& options = {}) const;
+
+    void print_heatmap(HeatmapPalette palette = HeatmapPalette::Ansi256) const;
+    std::string get_heatmap(HeatmapPalette palette = HeatmapPalette::Ansi256, const RenderOptions& options = {}) const;
 
-    void print_table();
-    std::string get_table();
+    void set_data(T* data, std::size_t size);
+    void print_new_rows(std::ostream& sink, AppendCursor& cursor, const RenderOptions& options = {}) const;
+    std::string get_new_rows(AppendCursor& cursor, const RenderOptions& options = {}) const;
+    std::string finalize(AppendCursor& cursor, const RenderOptions& options = {}) const;
+
+    void print_diff(const T* other, DiffOptions diff = {}) const requires std::equality_comparable<T>;
+    std::string get_diff(const T* other, DiffOptions diff = {}, const RenderOptions& options = {}) const requires std::equality_comparable<T>;
+
+    void set_memory_resource(std::pmr::memory_resource* resource);
+    void set_precision(unsigned int precision);
+    void set_number_format(NumberFormat format);
+    void set_column_priorities(std::vector<unsigned int> priorities, std::size_t min_column_width);
+
+    static void render_all(std::span<const TableSpec<T>> specs, std::ostream& sink, unsigned int threads = 0, RenderTrace* trace = nullptr);
 };
+
+#include "PlotterImpl.hpp"
+
+extern template class Plotter<int>;
+extern template class Plotter<long>;
+extern template class Plotter<long long>;
+extern template class Plotter<unsigned int>;
+extern template class Plotter<unsigned long>;
+extern template class Plotter<unsigned long long>;
+extern template class Plotter<double>;
+extern template class Plotter<float>;
+extern template class Plotter<long double>;
+extern template class Plotter<std::string>;
+extern template class Plotter<std::string_view>;
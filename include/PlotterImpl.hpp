@@ -0,0 +1,2378 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <bit>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+
+// Definitions of the Plotter templates, included at the end of Plotter.hpp.
+// Keeping them visible lets Plotter be instantiated for any Plottable type,
+// the common types are instantiated once in Plotter.cpp.
+
+// Counters of RenderStats, they expand to nothing unless PLOTTER_ENABLE_STATS is set.
+#if PLOTTER_ENABLE_STATS
+#define PLOTTER_STATS_TIMER(state, field) \
+    plotter_detail::StatsTimer plotter_stats_timer_##field((state).stats != nullptr ? &(state).stats->field : nullptr)
+#define PLOTTER_STATS_ADD(state, field, amount) \
+    do { if ((state).stats != nullptr) { (state).stats->field += (amount); } } while (false)
+#else
+#define PLOTTER_STATS_TIMER(state, field) static_cast<void>(0)
+#define PLOTTER_STATS_ADD(state, field, amount) static_cast<void>(sizeof(amount))
+#endif
+
+namespace plotter_detail {
+
+    constexpr std::size_t heatmap_levels = 256;
+
+    // full block character in UTF-8
+    constexpr const char* heatmap_glyph = "\xE2\x96\x88";
+
+    /**
+     * @brief Lookup table of pre-encoded escape sequences for one palette.
+     * 
+     * Each escape entry holds the complete color escape sequence followed by the block glyph,
+     * so rendering a cell is a single append of a precomputed string. Levels which end up
+     * with the same terminal color share one canonical level, so repeated colors are detected
+     * by comparing levels.
+     */
+    struct HeatmapLut {
+        std::array<std::string, heatmap_levels> escapes;
+        std::array<std::size_t, heatmap_levels> canonical_level;
+    };
+
+    const HeatmapLut& heatmap_lut(HeatmapPalette palette);
+
+    // number of consecutive tables claimed by a worker at once
+    constexpr std::size_t batch_chunk_size = 64;
+
+    // number of chunks per worker rendered before the output is emitted
+    constexpr std::size_t batch_chunks_per_wave = 16;
+
+    /**
+     * @brief Location of one rendered chunk inside the arena of the worker which rendered it.
+     */
+    struct BatchChunk {
+        std::size_t worker;
+        std::size_t offset;
+        std::size_t length;
+    };
+
+    /**
+     * @brief Memory resource which counts the allocations it passes to its upstream resource.
+     */
+    class CountingResource : public std::pmr::memory_resource {
+
+        std::pmr::memory_resource* _upstream;
+        std::size_t* _allocations;
+
+    protected:
+
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+        void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override;
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+    public:
+
+        CountingResource(std::pmr::memory_resource* upstream, std::size_t& allocations);
+
+        std::pmr::memory_resource* upstream() const {
+            return _upstream;
+        }
+    };
+
+    /**
+     * @brief Adds the lifetime of the timer to a time counter, a null counter disables the timer.
+     */
+    class StatsTimer {
+
+        std::chrono::nanoseconds* _total;
+        std::chrono::steady_clock::time_point _start;
+
+    public:
+
+        explicit StatsTimer(std::chrono::nanoseconds* total) : _total(total) {
+            if (_total != nullptr) {
+                _start = std::chrono::steady_clock::now();
+            }
+        }
+
+        ~StatsTimer() {
+            if (_total != nullptr) {
+                *_total += std::chrono::steady_clock::now() - _start;
+            }
+        }
+
+        StatsTimer(const StatsTimer&) = delete;
+        StatsTimer& operator=(const StatsTimer&) = delete;
+    };
+
+    /**
+     * @brief Records the lifetime of the scope as one event of a trace, a null trace disables it.
+     */
+    class TraceScope {
+
+        RenderTrace* _trace;
+        const char* _name;
+        std::size_t _first;
+        std::size_t _count;
+        std::chrono::steady_clock::time_point _start;
+
+    public:
+
+        TraceScope(RenderTrace* trace, const char* name, std::size_t first = RenderTrace::no_range, std::size_t count = 0)
+            : _trace(trace), _name(name), _first(first), _count(count) {
+            if (_trace != nullptr) {
+                _start = std::chrono::steady_clock::now();
+            }
+        }
+
+        ~TraceScope() {
+            if (_trace != nullptr) {
+                _trace->record(_name, _start, _first, _count);
+            }
+        }
+
+        TraceScope(const TraceScope&) = delete;
+        TraceScope& operator=(const TraceScope&) = delete;
+    };
+
+    // arithmetic types shown as numbers, characters and bool are not localized,
+    // signed char and unsigned char are the 8-bit integers and count as numbers
+    template <typename T>
+    constexpr bool is_number_v = std::is_arithmetic_v<T> && !std::is_same_v<T, bool> && !std::is_same_v<T, char>
+        && !std::is_same_v<T, wchar_t> && !std::is_same_v<T, char8_t> && !std::is_same_v<T, char16_t> && !std::is_same_v<T, char32_t>;
+
+    // slots of the value cache of one column, a power of two
+    constexpr std::size_t value_cache_slots = 256;
+
+    // lookups of a column before its hit rate is checked and the lowest hit rate in percent which keeps its cache
+    constexpr std::size_t value_cache_probe = 1024;
+    constexpr std::size_t value_cache_min_hit_percent = 50;
+
+    /**
+     * @brief Returns the slot of a number in the value cache of its column.
+     */
+    template <typename T>
+    std::size_t value_cache_slot(T value) {
+        std::uint64_t bits;
+        if constexpr (std::is_integral_v<T>) {
+            bits = static_cast<std::uint64_t>(value);
+        }
+        else if constexpr (sizeof(T) == sizeof(std::uint32_t)) {
+            bits = std::bit_cast<std::uint32_t>(value);
+        }
+        else {
+            bits = std::bit_cast<std::uint64_t>(static_cast<double>(value));
+        }
+        // floating point values differ mostly in their high bits, they are folded down before mixing
+        bits ^= bits >> 32;
+        return static_cast<std::size_t>((bits * 0x9E3779B97F4A7C15ull) >> 56);
+    }
+
+    /**
+     * @brief Tells whether two numbers are shown the same, zeros of different sign are not.
+     */
+    template <typename T>
+    bool same_number(T a, T b) {
+        if constexpr (std::is_floating_point_v<T>) {
+            return a == b && std::signbit(a) == std::signbit(b);
+        }
+        else {
+            return a == b;
+        }
+    }
+
+    /**
+     * @brief Sets changed[i] to 1 where after[i] differs from before[i] and to 0 elsewhere.
+     * 
+     * The loop has no branches, so the compiler vectorizes it. Floating point values which differ
+     * by at most epsilon, equal infinities and two NaNs are unchanged.
+     */
+    template <typename T>
+    void mark_changed(const T* before, const T* after, std::size_t count, double epsilon, unsigned char* changed) {
+        if constexpr (std::is_floating_point_v<T>) {
+            const T tolerance = static_cast<T>(epsilon);
+            for (std::size_t i = 0; i < count; i++) {
+                T a = before[i];
+                T b = after[i];
+                bool same = (a == b) | (std::abs(a - b) <= tolerance) | ((a != a) & (b != b));
+                changed[i] = static_cast<unsigned char>(!same);
+            }
+        }
+        else {
+            for (std::size_t i = 0; i < count; i++) {
+                changed[i] = static_cast<unsigned char>(!(before[i] == after[i]));
+            }
+        }
+    }
+
+    std::size_t localize_number(std::span<char> buffer, std::size_t length, const NumberFormat& format);
+
+    std::size_t wrap_line(std::string_view text, std::size_t position, std::size_t width, std::string_view& line);
+
+    void run_parallel(std::size_t task_count, unsigned int threads, const std::function<void(std::size_t, std::size_t)>& task);
+
+    /**
+     * @brief Output file resized to a fixed size and mapped into memory for writing.
+     * 
+     * The mapping is released and the file closed by the destructor.
+     */
+    class MappedFile {
+
+        int _file;
+        char* _data;
+        std::size_t _size;
+
+    public:
+
+        MappedFile(const std::string& path, std::size_t size);
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        char* data() const {
+            return _data;
+        }
+    };
+}
+
+
+/**
+ * @brief Constructs a Plotter object.
+ * 
+ * @tparam T The type of data stored in the Plotter.
+ * @param data Pointer to the data array.
+ * @param name The name of the Plotter.
+ * @param column_names Vector of column names.
+ * @param table_width The width of the table, zero takes the width of the terminal.
+ * @param size The size of the data array.
+ * @param data_arrangement The arrangement of the data in the table.
+ */
+template <Plottable T>
+Plotter<T>::Plotter(T* data, std::string name, std::vector<std::string> column_names, std::size_t table_width, std::size_t size, DataArrangement data_arrangement)
+    : _data(data), _codes(nullptr), _data_arrangement(data_arrangement), _column_names(std::move(column_names)), _name(std::move(name)), _table_width(table_width), _size(size) {
+    initialize();
+}
+
+/**
+ * @brief Constructs a Plotter object over dictionary-encoded data.
+ * 
+ * Every cell holds a code, the index of its value in the dictionary. A render measures and pads
+ * every dictionary entry once, the rows are then gathered from the padded entries by their codes,
+ * so repeated labels cost a copy per cell.
+ * 
+ * @tparam T The type of the dictionary entries, a string-like type.
+ * @param codes Pointer to the array of codes.
+ * @param dictionary The values the codes refer to.
+ * @param name The name of the Plotter.
+ * @param column_names Vector of column names.
+ * @param table_width The width of the table, zero takes the width of the terminal.
+ * @param size The size of the code array.
+ * @param data_arrangement The arrangement of the codes in the table.
+ * @throws std::invalid_argument If the code pointer is null or a code is outside the dictionary.
+ */
+template <Plottable T>
+Plotter<T>::Plotter(const std::uint32_t* codes, std::vector<T> dictionary, std::string name, std::vector<std::string> column_names, std::size_t table_width, std::size_t size, DataArrangement data_arrangement) requires CellText<T>
+    : _data(nullptr), _codes(codes), _dictionary(std::move(dictionary)), _data_arrangement(data_arrangement), _column_names(std::move(column_names)), _name(std::move(name)), _table_width(table_width), _size(size) {
+    initialize();
+    const std::uint32_t* end = _codes + _size;
+    if (std::any_of(_codes, end, [&](std::uint32_t code) { return code >= _dictionary.size(); })) {
+        throw std::invalid_argument("Plotter: code outside of the dictionary.");
+    }
+}
+
+/**
+ * @brief Makes the Plotter show the table of a spec, as if it was constructed from it.
+ * 
+ * The strings and vectors of the previous table are overwritten in place, so a Plotter
+ * reused for tables of similar shape stops allocating. All settings return to their defaults.
+ * 
+ * @tparam T The type of data stored in the Plotter.
+ * @param spec The table to show.
+ * @throws std::invalid_argument If the spec is invalid.
+ */
+template <Plottable T>
+void Plotter<T>::assign(const TableSpec<T>& spec) {
+    _data = spec.data;
+    _codes = nullptr;
+    _dictionary.clear();
+    _data_arrangement = spec.data_arrangement;
+    _column_names.assign(spec.column_names.begin(), spec.column_names.end());
+    _name.assign(spec.name);
+    _table_width = spec.table_width;
+    _size = spec.size;
+    _number_format = NumberFormat();
+    initialize();
+}
+
+/**
+ * @brief Validates the inputs and sets up the layout, shared by the constructors.
+ * 
+ * @tparam T The type of data stored in the Plotter.
+ */
+template <Plottable T>
+void Plotter<T>::initialize() {
+    _auto_width = _table_width == 0;
+    if (_auto_width) {
+        _table_width = terminal_width();
+    }
+    validate_inputs_throw_exception();
+    _cols = _column_names.size();
+    _rows = calculate_rows(_size, _cols);
+    _full_rows = calculate_full_rows();
+    _column_priorities.assign(_cols, 0);
+    _min_column_width = 0;
+    _precision = 8;
+    _localized = false;
+    _memory_resource = std::pmr::get_default_resource();
+    update_layout();
+}
+
+/**
+ * @brief Sets the memory resource used for the transient allocations of a render.
+ * 
+ * If the resource is a RenderArena, it is reset after every render, so the memory
+ * is reused by the next one. Any other resource is used as is.
+ * A RenderArena is not thread-safe, concurrent renders have to pass their own
+ * resource in RenderOptions instead.
+ * 
+ * @tparam T The type of data in the table.
+ * @param resource The memory resource, nullptr selects the default resource.
+ */
+template <Plottable T>
+void Plotter<T>::set_memory_resource(std::pmr::memory_resource* resource) {
+    _memory_resource = resource != nullptr ? resource : std::pmr::get_default_resource();
+}
+
+/**
+ * @brief Hides the columns with the lowest priority when the columns are too narrow.
+ * 
+ * As long as the column width is below min_column_width or below the name of a shown column,
+ * the column with the lowest priority is removed from the table, among equal priorities
+ * the rightmost one. At least one column stays. Hidden columns are neither formatted nor shown,
+ * the shown ones keep their order.
+ * 
+ * @tparam T The type of data in the table.
+ * @param priorities The priority of every column, higher priorities are kept longer.
+ * @param min_column_width The narrowest column which is still shown.
+ * @throws std::invalid_argument If the number of priorities differs from the number of columns.
+ */
+template <Plottable T>
+void Plotter<T>::set_column_priorities(std::vector<unsigned int> priorities, std::size_t min_column_width) {
+    if (priorities.size() != _cols) {
+        throw std::invalid_argument("Plotter: every column needs a priority.");
+    }
+    _column_priorities = std::move(priorities);
+    _min_column_width = min_column_width;
+    update_layout();
+}
+
+/**
+ * @brief Chooses the shown columns and computes their width and cell offsets.
+ * 
+ * Columns are hidden when a minimum width is set or the width is taken from the terminal.
+ * The columns have to be as wide as the minimum and as the names of the shown columns,
+ * with the terminal width also as wide as the default cell, so the layout of the shown
+ * columns is valid whenever hiding can make it valid.
+ * 
+ * @tparam T The type of data in the table.
+ */
+template <Plottable T>
+void Plotter<T>::update_layout() {
+    _shown_columns.resize(_cols);
+    for (std::size_t j = 0; j < _cols; j++) {
+        _shown_columns[j] = j;
+    }
+
+    // the columns by priority, the first _shown_cols of them are shown
+    // without priorities the order stays, as sorting would allocate for every table of render_all
+    bool prioritized = std::any_of(_column_priorities.begin(), _column_priorities.end(), [&](unsigned int priority) {
+        return priority != _column_priorities.front();
+    });
+    if (prioritized) {
+        std::stable_sort(_shown_columns.begin(), _shown_columns.end(), [&](std::size_t a, std::size_t b) {
+            return _column_priorities[a] > _column_priorities[b];
+        });
+    }
+
+    _shown_cols = _cols;
+    if (_auto_width || _min_column_width != 0) {
+        std::size_t min_column_width = _min_column_width;
+        if (_auto_width) {
+            std::array<char, cell_buffer_size> buffer;
+            min_column_width = std::max(min_column_width, format_cell(T(), buffer).length());
+        }
+        auto widest_name = [&](std::size_t shown_cols) {
+            std::size_t widest = 0;
+            for (std::size_t j = 0; j < shown_cols; j++) {
+                widest = std::max(widest, _column_names[_shown_columns[j]].length());
+            }
+            return widest;
+        };
+        while (_shown_cols > 1 && calculate_column_width(_table_width, _shown_cols) < std::max(min_column_width, widest_name(_shown_cols))) {
+            _shown_cols--;
+        }
+    }
+    _column_width = calculate_column_width(_table_width, _shown_cols);
+
+    if (_shown_cols < _cols) {
+        _shown_columns.resize(_shown_cols);
+        std::sort(_shown_columns.begin(), _shown_columns.end());
+    }
+
+    std::size_t stride = _data_arrangement == DataArrangement::RowMajor ? 1 : _rows;
+    _cell_offsets.resize(_shown_cols);
+    for (std::size_t j = 0; j < _shown_cols; j++) {
+        _cell_offsets[j] = _shown_columns[j] * stride;
+    }
+}
+
+/**
+ * @brief Sets the decimal point and the thousands separator of numeric cells.
+ * 
+ * The characters are applied to the std::to_chars output inside the cell buffer,
+ * so localized tables do not need a stream or a locale.
+ * 
+ * @tparam T The type of data in the table.
+ * @param format The characters, the default format leaves the numbers as they are.
+ */
+template <Plottable T>
+void Plotter<T>::set_number_format(NumberFormat format) {
+    _number_format = format;
+    _localized = format.decimal_point != '.' || format.thousands_separator != '\0';
+    if (_auto_width) {
+        update_layout();
+    }
+}
+
+/**
+ * @brief Sets the number of decimal places of floating point cells, 8 by default.
+ * 
+ * Both cell engines use the precision, so their outputs stay comparable for any value of it.
+ * The fixed notation of the largest value, its sign and its decimal point have to fit the cell buffer.
+ * long double is bounded by the exponents of double, its larger values fall back to the general notation.
+ * 
+ * @tparam T The type of data in the table.
+ * @param precision The number of decimal places.
+ * @throws std::invalid_argument If the formatted values could not fit the cell buffer.
+ */
+template <Plottable T>
+void Plotter<T>::set_precision(unsigned int precision) {
+    std::size_t integer_digits = 0;
+    if constexpr (std::is_floating_point_v<T>) {
+        integer_digits = std::min(std::numeric_limits<T>::max_exponent10, std::numeric_limits<double>::max_exponent10);
+    }
+    if (integer_digits + precision + 3 >= cell_buffer_size) {
+        throw std::invalid_argument("Plotter: precision is too large.");
+    }
+    _precision = precision;
+    if (_auto_width) {
+        update_layout();
+    }
+}
+
+/**
+ * @brief Creates the state of a single render.
+ * 
+ * All mutable data of a render lives in the returned state, so any number of renders
+ * of the same Plotter can run concurrently. When the render collects statistics,
+ * its memory resource is wrapped by one which counts the allocations.
+ * 
+ * @tparam T The type of data in the table.
+ * @param options The options of the render.
+ * @param table The output of the render.
+ * @return The state of the render.
+ */
+template <Plottable T>
+typename Plotter<T>::RenderState Plotter<T>::make_render_state(const RenderOptions& options, TableWriter table) const {
+    std::size_t first_row = std::min<std::size_t>(options.first_row, _rows);
+    std::size_t row_count = std::min<std::size_t>(options.row_count, _rows - first_row);
+
+    // columns per page, all shown columns unless they have to be paged
+    std::size_t page_columns = _shown_cols;
+    if (options.paged_column_width != 0) {
+        while (page_columns > 1 && calculate_column_width(_table_width, page_columns) < options.paged_column_width) {
+            page_columns--;
+        }
+    }
+
+    std::pmr::memory_resource* memory_resource = options.memory_resource != nullptr ? options.memory_resource : _memory_resource;
+
+    RenderStats* stats = nullptr;
+    std::unique_ptr<plotter_detail::CountingResource> counting_resource;
+#if PLOTTER_ENABLE_STATS
+    if (options.stats != nullptr) {
+        stats = options.stats;
+        counting_resource = std::make_unique<plotter_detail::CountingResource>(memory_resource, stats->allocations);
+        memory_resource = counting_resource.get();
+    }
+#endif
+
+    return RenderState{
+        table,
+        memory_resource,
+        _data,
+        first_row,
+        first_row + row_count,
+        0,
+        page_columns,
+        page_columns == _shown_cols ? _column_width : calculate_column_width(_table_width, page_columns),
+        page_columns,
+        _table_width,
+        options.wrap_cells,
+        options.value_cache,
+        stats,
+        options.trace,
+        options.engine,
+        std::move(counting_resource),
+        std::pmr::string(memory_resource),
+        std::pmr::string(memory_resource),
+        std::pmr::vector<std::string_view>(memory_resource),
+        std::pmr::vector<std::size_t>(memory_resource),
+        std::pmr::vector<plotter_detail::CachedValue<T>>(memory_resource),
+        std::pmr::vector<plotter_detail::ValueCacheColumn>(memory_resource),
+        std::pmr::string(memory_resource),
+        std::pmr::vector<char>(memory_resource),
+        std::pmr::vector<std::size_t>(memory_resource),
+        nullptr,
+        DiffMode::AllRows
+    };
+}
+
+/**
+ * @brief Frees the transient memory of the finished render.
+ * 
+ * @tparam T The type of data in the table.
+ * @param state The state of the finished render.
+ */
+template <Plottable T>
+void Plotter<T>::release_transient_memory(RenderState& state) const {
+    std::pmr::memory_resource* resource = state.counting_resource != nullptr ? state.counting_resource->upstream() : state.memory_resource;
+    if (RenderArena* arena = dynamic_cast<RenderArena*>(resource)) {
+        arena->reset();
+    }
+}
+
+/**
+ * @brief Renders the table header, the columns header and the content.
+ * 
+ * A paged render repeats them for every page of columns.
+ * 
+ * @tparam T The type of data in the table.
+ * @param state The state of the render.
+ */
+template <Plottable T>
+void Plotter<T>::render(RenderState& state) const {
+    for (std::size_t first_column = 0; first_column < _shown_cols; first_column += state.page_columns) {
+        select_page(state, first_column);
+        {
+            PLOTTER_STATS_TIMER(state, frame_time);
+            {
+                plotter_detail::TraceScope trace(state.trace, "table_header");
+                print_table_header(state);
+            }
+            plotter_detail::TraceScope trace(state.trace, "columns_header", state.first_column, state.column_count);
+            print_columns_header(state);
+        }
+        print_content(state);
+    }
+}
+
+/**
+ * @brief Restricts the render to the page of columns starting at first_column.
+ * 
+ * @tparam T The type of data in the table.
+ * @param state The state of the render.
+ * @param first_column The index of the first shown column of the page.
+ */
+template <Plottable T>
+void Plotter<T>::select_page(RenderState& state, std::size_t first_column) const {
+    state.first_column = first_column;
+    state.column_count = std::min(state.page_columns, _shown_cols - first_column);
+    state.frame_width = page_width(state.page_columns, state.column_count, state.column_width);
+    state.row_template.clear();
+}
+
+/**
+ * @brief Prints the table with headers and content.
+ * 
+ * This function prints the table with headers and content to the standard output.
+ * 
+ * @tparam T The type of data in the table.
+ */
+template <Plottable T>
+void Plotter<T>::print_table() const {
+    print_table(std::cout);
+}
+
+/**
+ * @brief Prints the table with headers and content to the sink.
+ * 
+ * This function prints the table with headers and content. It first prints the table header,
+ * followed by the columns header, and then the content. Finally, it outputs the table as a string.
+ * 
+ * @tparam T The type of data in the table.
+ * @param sink The stream the table is written to.
+ * @param options The options of the render.
+ */
+template <Plottable T>
+void Plotter<T>::print_table(std::ostream& sink, const RenderOptions& options) const {
+    std::string table;
+    table.reserve(frame_size(make_render_state(options)));
+    RenderState state = make_render_state(options, TableWriter(table));
+    try {
+        render(state);
+    }
+    catch (const std::exception& e) {
+        sink << "Error printing table: " << e.what();
+    }
+    catch (...) {
+        sink << "Error: An unknown error occurred while printing the table.";
+    }
+    state.table += "\n";
+    release_transient_memory(state);
+    state.table.finish();
+    PLOTTER_STATS_ADD(state, allocations, state.table.allocations());
+    PLOTTER_STATS_ADD(state, bytes_emitted, table.size());
+
+    PLOTTER_STATS_TIMER(state, sink_time);
+    plotter_detail::TraceScope trace(state.trace, "sink_write");
+    sink.write(table.data(), static_cast<std::streamsize>(table.size()));
+}
+
+/**
+ * @brief Get the table as a string.
+ * 
+ * This function generates a table by printing the table header, columns header, and content.
+ * It returns the generated table as a string.
+ * 
+ * @tparam T The type of data in the table.
+ * @param options The options of the render.
+ * @return std::string The generated table as a string.
+ */
+template <Plottable T>
+std::string Plotter<T>::get_table(const RenderOptions& options) const {
+    std::string table;
+    table.reserve(frame_size(make_render_state(options)));
+    append_table(table, options);
+    return table;
+}
+
+/**
+ * @brief Appends the table to the end of a string.
+ * 
+ * @tparam T The type of data in the table.
+ * @param out The string the table is appended to.
+ * @param options The options of the render.
+ */
+template <Plottable T>
+void Plotter<T>::append_table(std::string& out, const RenderOptions& options) const {
+    RenderState state = make_render_state(options, TableWriter(out));
+    try {
+        render(state);
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error printing table: " + _name + "\n" << e.what() <<  "\n";
+    }
+    catch (...) {
+        std::cerr << "Error: An unknown error occurred while printing the table: " + _name + "\n";
+    }
+
+    state.table += "\n";
+    release_transient_memory(state);
+    std::size_t written = state.table.finish();
+    PLOTTER_STATS_ADD(state, allocations, state.table.allocations());
+    PLOTTER_STATS_ADD(state, bytes_emitted, written);
+}
+
+/**
+ * @brief Renders the table directly into a caller-provided buffer.
+ * 
+ * The size of the table is computed first by rendered_size(). If the table fits, it is written
+ * straight into the destination without any intermediate copy, otherwise the destination is left untouched.
+ * 
+ * @tparam T The type of data in the table.
+ * @param destination The buffer the table is written to.
+ * @param options The options of the render.
+ * @return The number of bytes written and the number of bytes the table needs.
+ * @throws std::length_error If the table width is too small for the name or the column names.
+ */
+template <Plottable T>
+RenderResult Plotter<T>::render_into(std::span<char> destination, const RenderOptions& options) const {
+    std::size_t required = rendered_size(options);
+    if (required > destination.size()) {
+        return RenderResult{ 0, required };
+    }
+
+    RenderState state = make_render_state(options, TableWriter(destination));
+    render(state);
+    state.table += "\n";
+    release_transient_memory(state);
+    std::size_t written = state.table.finish();
+    PLOTTER_STATS_ADD(state, bytes_emitted, written);
+    return RenderResult{ written, required };
+}
+
+/**
+ * @brief Writes the table into a file, the rows are rendered in parallel.
+ * 
+ * The rows are split into chunks. The workers first compute the exact size of every chunk,
+ * the file is then resized to the size of the table and mapped into memory, and the workers
+ * render their chunks straight into the mapping at the offsets given by the chunk sizes.
+ * Where memory mapping is not available and for paged renders, the table is rendered and written sequentially.
+ * 
+ * @tparam T The type of data in the table.
+ * @param path The path of the output file, an existing file is overwritten.
+ * @param threads The number of worker threads, zero selects the hardware concurrency.
+ * @param options The options of the render, the memory resource is ignored as the workers use their own arenas.
+ * @throws std::length_error If the table width is too small for the name or the column names.
+ * @throws std::system_error If the file cannot be created, resized or mapped.
+ */
+template <Plottable T>
+void Plotter<T>::write_file(const std::string& path, unsigned int threads, const RenderOptions& options) const {
+    RenderState whole = make_render_state(options);
+    validate_layout_throw_exception(whole);
+
+    auto write_sequentially = [&]() {
+        std::string table = get_table(options);
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file.write(table.data(), static_cast<std::streamsize>(table.size()))) {
+            throw std::system_error(std::make_error_code(std::errc::io_error), "Plotter: cannot write output file " + path);
+        }
+    };
+
+#if defined(_WIN32)
+    write_sequentially();
+#else
+    if (whole.page_columns < _shown_cols) {
+        write_sequentially();
+        return;
+    }
+
+    std::size_t rows = whole.last_row - whole.first_row;
+
+    std::size_t worker_count = threads != 0 ? threads : std::max(1u, std::thread::hardware_concurrency());
+    std::size_t chunk_rows = std::max<std::size_t>(1, (rows + worker_count * 8 - 1) / (worker_count * 8));
+    std::size_t chunk_count = (rows + chunk_rows - 1) / chunk_rows;
+
+    std::vector<std::unique_ptr<RenderArena>> arenas;
+    for (std::size_t worker = 0; worker < std::max<std::size_t>(1, std::min(worker_count, chunk_count)); worker++) {
+        arenas.push_back(std::make_unique<RenderArena>());
+    }
+    std::vector<RenderStats> worker_stats(arenas.size());
+
+    auto chunk_options = [&](std::size_t worker, std::size_t chunk) {
+        RenderOptions chunk_window = options;
+        chunk_window.first_row = whole.first_row + chunk * chunk_rows;
+        chunk_window.row_count = std::min(chunk_rows, whole.last_row - chunk_window.first_row);
+        chunk_window.memory_resource = arenas[worker].get();
+        chunk_window.stats = options.stats != nullptr ? &worker_stats[worker] : nullptr;
+        return chunk_window;
+    };
+
+    // offsets[i] is the position of chunk i in the file, the last entry is the end of the rows
+    std::vector<std::size_t> offsets(chunk_count + 1, 0);
+    plotter_detail::run_parallel(chunk_count, threads, [&](std::size_t worker, std::size_t chunk) {
+        RenderState state = make_render_state(chunk_options(worker, chunk));
+        plotter_detail::TraceScope trace(state.trace, "measure_rows", state.first_row, state.last_row - state.first_row);
+        offsets[chunk + 1] = (state.last_row - state.first_row) * row_size(state.column_count, state.column_width) + content_size(state);
+    });
+    offsets[0] = header_size(whole.column_count, whole.column_width, whole.frame_width);
+    for (std::size_t chunk = 0; chunk < chunk_count; chunk++) {
+        offsets[chunk + 1] += offsets[chunk];
+    }
+    std::size_t size = offsets[chunk_count] + _table_width + 2;
+
+    plotter_detail::MappedFile file(path, size);
+    char* output = file.data();
+
+    RenderState header = make_render_state(options, TableWriter(std::span<char>(output, offsets[0])));
+    {
+        PLOTTER_STATS_TIMER(header, frame_time);
+        {
+            plotter_detail::TraceScope trace(header.trace, "table_header");
+            print_table_header(header);
+        }
+        plotter_detail::TraceScope trace(header.trace, "columns_header");
+        print_columns_header(header);
+    }
+
+    plotter_detail::run_parallel(chunk_count, threads, [&](std::size_t worker, std::size_t chunk) {
+        std::span<char> destination(output + offsets[chunk], offsets[chunk + 1] - offsets[chunk]);
+        RenderState state = make_render_state(chunk_options(worker, chunk), TableWriter(destination));
+        print_rows(state);
+        release_transient_memory(state);
+    });
+
+    RenderState footer = make_render_state(options, TableWriter(std::span<char>(output + offsets[chunk_count], size - offsets[chunk_count])));
+    {
+        PLOTTER_STATS_TIMER(footer, frame_time);
+        print_endline(footer);
+        footer.table += "\n";
+    }
+
+    if (options.stats != nullptr) {
+        for (const RenderStats& stats : worker_stats) {
+            *options.stats += stats;
+        }
+    }
+    PLOTTER_STATS_ADD(footer, bytes_emitted, size);
+#endif
+}
+
+/**
+ * @brief Prints the table header.
+ * 
+ * This function calculates the left and right padding for the table header based on the width of the page and the length of the name.
+ * It then prints the table header with the name centered.
+ * 
+ * @tparam T The type of the Plotter.
+ * @param state The state of the render.
+ */
+template <Plottable T>
+void Plotter<T>::print_table_header(RenderState& state) const {
+
+    std::ptrdiff_t free_width = static_cast<std::ptrdiff_t>(state.frame_width) - static_cast<std::ptrdiff_t>(_name.length()) - 2;
+    std::ptrdiff_t left_padding = free_width >= 0 ? free_width / 2 : free_width;
+    std::ptrdiff_t right_padding = free_width - left_padding;
+
+    state.table += "\n";
+    print_endline(state);
+    state.table += "|";
+    print_repeated(state, ' ', left_padding);
+    state.table += _name;
+    print_repeated(state, ' ', right_padding);
+    state.table += "|\n";
+    print_endline(state);
+}
+
+/**
+ * @brief Prints the header of the columns in the table.
+ * 
+ * This function prints the header of the columns in the table. It iterates over the column names,
+ * calculates the padding for each column, and prints the header with the appropriate padding.
+ * 
+ * @tparam T The type of data stored in the table.
+ * @param state The state of the render.
+ */
+template <Plottable T>
+void Plotter<T>::print_columns_header(RenderState& state) const {
+    state.table += "|";
+    for (std::size_t i = state.first_column; i < state.first_column + state.column_count; i++) {
+        const std::string& header = _column_names[_shown_columns[i]];
+        std::ptrdiff_t free_width = static_cast<std::ptrdiff_t>(state.column_width) - static_cast<std::ptrdiff_t>(header.length());
+        std::ptrdiff_t left_padding = free_width >= 0 ? free_width / 2 : free_width;
+        std::ptrdiff_t right_padding = free_width - left_padding;
+        print_repeated(state, ' ', left_padding);
+        state.table += header;
+        print_repeated(state, ' ', right_padding);
+        state.table += "|";
+    }
+    state.table += "\n";
+    print_endline(state);
+}
+
+/**
+ * @brief Prints the content of the Plotter object followed by the closing line.
+ * 
+ * @param state The state of the render.
+ */
+template <Plottable T>
+void Plotter<T>::print_content(RenderState& state) const {
+    print_rows(state);
+    PLOTTER_STATS_TIMER(state, frame_time);
+    print_endline(state);
+}
+
+/**
+ * @brief Prints the rows of the Plotter object.
+ * 
+ * This function prints the rows of the Plotter object based on the data arrangement.
+ * If the data arrangement is set to RowMajor, it prints each row of the data array.
+ * If the data arrangement is set to ColumnMajor, it prints each column of the data array.
+ * Only the rows inside the window of the render are printed.
+ * 
+ * All rows share one byte layout, so the frame of a row is built once as a template
+ * of pipes, padding and newline, which every row copies before its values are placed into the slots.
+ * The full rows are printed by a loop without any per-cell checks, the rows after them
+ * are printed by a separate tail loop which passes the number of cells the row really has.
+ * 
+ * @param state The state of the render.
+ */
+template <Plottable T>
+void Plotter<T>::print_rows(RenderState& state) const {
+    PLOTTER_STATS_TIMER(state, format_time);
+    plotter_detail::TraceScope trace(state.trace, "rows", state.first_row, state.last_row - state.first_row);
+    std::array<char, cell_buffer_size> buffer;
+    state.default_cell = format_cell(T(), buffer, state.engine);
+
+    // the template is usable only when every cell fits its slot,
+    // values which are too long are replaced by the default value
+    if (state.default_cell.length() <= state.column_width) {
+        state.row_template.assign(1, '|');
+        for (std::size_t j = 0; j < state.column_count; j++) {
+            state.row_template.append(state.column_width, ' ');
+            state.row_template += '|';
+        }
+        state.row_template += '\n';
+    }
+
+    if constexpr (CellText<T>) {
+        if (state.wrap_cells && state.column_width != 0 && state.changed_cells == nullptr) {
+            for (std::size_t i = state.first_row; i < state.last_row; i++) {
+                print_wrapped_row(state, row_start_index(i), page_cell_count(state, i));
+            }
+            return;
+        }
+
+        // dictionary-encoded rows are gathered from the padded entries
+        if (_codes != nullptr && !state.row_template.empty()) {
+            pad_dictionary(state);
+            for (std::size_t i = state.first_row; i < state.last_row; i++) {
+                print_dictionary_row(state, row_start_index(i), page_cell_count(state, i));
+            }
+            return;
+        }
+    }
+
+    // every column of the page starts with an empty cache
+    if constexpr (plotter_detail::is_number_v<T>) {
+        if (state.value_cache) {
+            state.cache_columns.assign(state.column_count, plotter_detail::ValueCacheColumn{ 0, 0, true });
+            state.cached_values.assign(state.column_count * plotter_detail::value_cache_slots, plotter_detail::CachedValue<T>{});
+        }
+    }
+
+    if (state.changed_cells != nullptr) {
+        print_diff_rows(state);
+    }
+    else {
+        // full rows first, every one of them has all cells of the page
+        std::size_t full_end = std::min(state.last_row, _full_rows);
+        if (_data_arrangement == DataArrangement::RowMajor) {
+            for (std::size_t i = state.first_row; i < full_end; i++) {
+                print_row(state, i * _cols, state.column_count);
+            }
+        }
+        else {
+            for (std::size_t i = state.first_row; i < full_end; i++) {
+                print_row(state, i, state.column_count);
+            }
+        }
+
+        // the tail rows are missing some of their trailing cells
+        for (std::size_t i = std::max(state.first_row, _full_rows); i < state.last_row; i++) {
+            print_row(state, row_start_index(i), page_cell_count(state, i));
+        }
+    }
+
+    for (const plotter_detail::ValueCacheColumn& cache : state.cache_columns) {
+        PLOTTER_STATS_ADD(state, cache_lookups, cache.lookups);
+        PLOTTER_STATS_ADD(state, cache_hits, cache.hits);
+    }
+}
+
+/**
+ * @brief Prints a row of data in a table format.
+ * 
+ * This function prints a row of data in a table format, where each cell represents a value from the data array.
+ * If a value is longer than the specified column width, it is stored in a buffer and printed at the end of the row.
+ * The row is a copy of the row template with the values right-justified into their slots.
+ * Without a template the cells are appended one by one, a default value wider than the column
+ * widens its cell. A diff gets the offsets of the separators left of the cells in cell_separators.
+ * 
+ * @tparam T The type of data stored in the array.
+ * @param state The state of the render.
+ * @param start_index The starting index of the row in the data array.
+ * @param cell_count The number of cells to print in the row, the remaining columns are left blank.
+ */
+template <Plottable T>
+void Plotter<T>::print_row(RenderState& state, std::size_t start_index, std::size_t cell_count) const {
+
+    // buffer for values which are longer than the column width
+    // they will be stored and printed at the end of the row
+    std::pmr::string too_long_values_buffer(state.memory_resource);
+
+    TableWriter& table = state.table;
+    std::array<char, cell_buffer_size> buffer;
+    PLOTTER_STATS_ADD(state, cells_formatted, cell_count);
+    const std::size_t column_width = state.column_width;
+    const std::size_t* cell_offsets = _cell_offsets.data() + state.first_column;
+
+    auto cell_text = [&](std::size_t j) {
+        const T& value = value_at(state, start_index + cell_offsets[j]);
+        std::string_view text = format_cached(state, j, value, buffer);
+
+        if (text.length() > column_width) {
+            append_overflow(state, too_long_values_buffer, j, value);
+
+            // replace by default T value
+            text = state.default_cell;
+        }
+        return text;
+    };
+
+    std::pmr::vector<std::size_t>& separators = state.cell_separators;
+    const bool diff = state.changed_cells != nullptr;
+    if (diff) {
+        separators.resize(cell_count);
+    }
+
+    if (!state.row_template.empty()) {
+        char* slot_end = table.append(state.row_template) + 1 + column_width;
+        for (std::size_t j = 0; j < cell_count; j++) {
+            std::string_view text = cell_text(j);
+            std::memcpy(slot_end - text.length(), text.data(), text.length());
+            slot_end += column_width + 1;
+        }
+        if (diff) {
+            for (std::size_t j = 0; j < cell_count; j++) {
+                separators[j] = j * (column_width + 1);
+            }
+        }
+    }
+    else {
+        std::size_t row_begin = table.size();
+        table += '|';
+        for (std::size_t j = 0; j < cell_count; j++) {
+            std::string_view text = cell_text(j);
+            if (diff) {
+                separators[j] = table.size() - 1 - row_begin;
+            }
+            if (text.length() < column_width) {
+                table.append(column_width - text.length(), ' ');
+            }
+            table += text;
+            table += '|';
+        }
+        for (std::size_t j = cell_count; j < state.column_count; j++) {
+            table.append(column_width, ' ');
+            table += '|';
+        }
+        table += '\n';
+    }
+
+    // too long values are printed without formatting because of complexity
+    if (!too_long_values_buffer.empty()) {
+        table.pop_back();
+        table += too_long_values_buffer;
+        table += '\n';
+    }
+}
+
+/**
+ * @brief Prints the rows of a diff and marks their changed cells.
+ * 
+ * A changed cell gets '*' in place of the separator on its left, at the offset print_row
+ * reports for it, so cells widened by their default value are marked correctly. In ChangedRows mode
+ * the rows without a changed cell on the page are skipped and every run of printed rows
+ * starts with a line giving the index of its first row.
+ * 
+ * @tparam T The type of data in the table.
+ * @param state The state of the render, provides the changed cells.
+ */
+template <Plottable T>
+void Plotter<T>::print_diff_rows(RenderState& state) const {
+    const std::size_t* cell_offsets = _cell_offsets.data() + state.first_column;
+    const unsigned char* changed = state.changed_cells;
+    std::size_t next_row = static_cast<std::size_t>(-1);
+
+    for (std::size_t i = state.first_row; i < state.last_row; i++) {
+        std::size_t start_index = row_start_index(i);
+        std::size_t cell_count = page_cell_count(state, i);
+        bool row_changed = false;
+        for (std::size_t j = 0; j < cell_count; j++) {
+            row_changed |= changed[start_index + cell_offsets[j]] != 0;
+        }
+
+        if (state.diff_mode == DiffMode::ChangedRows) {
+            if (!row_changed) {
+                continue;
+            }
+            if (i != next_row) {
+                std::array<char, 24> index_buffer;
+                state.table += "row: ";
+                state.table += std::string_view(index_buffer.data(), std::to_chars(index_buffer.data(), index_buffer.data() + index_buffer.size(), i).ptr - index_buffer.data());
+                state.table += '\n';
+            }
+            next_row = i + 1;
+        }
+
+        std::size_t row_begin = state.table.size();
+        print_row(state, start_index, cell_count);
+        if (row_changed) {
+            // the row may have moved the output, it is addressed by its offset
+            char* row = state.table.data() + row_begin;
+            for (std::size_t j = 0; j < cell_count; j++) {
+                if (changed[start_index + cell_offsets[j]] != 0) {
+                    row[state.cell_separators[j]] = '*';
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Prints a row of dictionary-encoded cells.
+ * 
+ * Every cell is a copy of the padded dictionary entry its code selects, nothing is formatted or measured.
+ * Entries which are too long for the column are padded as the default value and reported after the row.
+ * 
+ * @tparam T The type of the dictionary entries.
+ * @param state The state of the render, provides the padded entries.
+ * @param start_index The starting index of the row in the code array.
+ * @param cell_count The number of cells to print in the row, the remaining columns are left blank.
+ */
+template <Plottable T>
+void Plotter<T>::print_dictionary_row(RenderState& state, std::size_t start_index, std::size_t cell_count) const {
+    std::pmr::string too_long_values_buffer(state.memory_resource);
+
+    TableWriter& table = state.table;
+    PLOTTER_STATS_ADD(state, cells_formatted, cell_count);
+    const std::size_t column_width = state.column_width;
+    const std::size_t* cell_offsets = _cell_offsets.data() + state.first_column;
+    const char* padded_entries = state.padded_entries.data();
+
+    char* slot = table.append(state.row_template) + 1;
+    for (std::size_t j = 0; j < cell_count; j++) {
+        std::size_t code = _codes[start_index + cell_offsets[j]];
+        std::memcpy(slot, padded_entries + code * column_width, column_width);
+        if (state.long_entries[code] != 0) {
+            append_overflow(state, too_long_values_buffer, j, _dictionary[code]);
+        }
+        slot += column_width + 1;
+    }
+
+    if (!too_long_values_buffer.empty()) {
+        table.pop_back();
+        table += too_long_values_buffer;
+        table += '\n';
+    }
+}
+
+/**
+ * @brief Measures and right-justifies every dictionary entry once for the column width of the render.
+ * 
+ * The entries are kept back to back, column width bytes each, in the state of the render,
+ * so all pages of the render share them.
+ * 
+ * @tparam T The type of the dictionary entries.
+ * @param state The state of the render.
+ */
+template <Plottable T>
+void Plotter<T>::pad_dictionary(RenderState& state) const {
+    if (!state.long_entries.empty()) {
+        return;
+    }
+
+    const std::size_t column_width = state.column_width;
+    std::array<char, cell_buffer_size> buffer;
+    state.padded_entries.assign(_dictionary.size() * column_width, ' ');
+    state.long_entries.assign(_dictionary.size(), 0);
+    for (std::size_t k = 0; k < _dictionary.size(); k++) {
+        std::string_view text = format_cell(_dictionary[k], buffer, state.engine);
+        if (text.length() > column_width) {
+            state.long_entries[k] = 1;
+            text = state.default_cell;
+        }
+        std::memcpy(state.padded_entries.data() + (k + 1) * column_width - text.length(), text.data(), text.length());
+    }
+}
+
+/**
+ * @brief Appends the report of a value which is too long for its cell.
+ * 
+ * @tparam T The type of the value.
+ * @param state The state of the render.
+ * @param out The reports of the row.
+ * @param column The index of the column in the page.
+ * @param value The value which is too long.
+ */
+template <Plottable T>
+void Plotter<T>::append_overflow(RenderState& state, std::pmr::string& out, std::size_t column, const T& value) const {
+    PLOTTER_STATS_TIMER(state, overflow_time);
+    PLOTTER_STATS_ADD(state, overflow_cells, 1);
+    std::array<char, cell_buffer_size> plain_buffer;
+    std::array<char, 24> index_buffer;
+    char* index_end = std::to_chars(index_buffer.data(), index_buffer.data() + index_buffer.size(), state.first_column + column).ptr;
+
+    out += "\n\ncell: ";
+    out.append(index_buffer.data(), index_end);
+    out += " value: ";
+    out += format_plain(value, plain_buffer, state.engine);
+}
+
+/**
+ * @brief Prints a row of text cells, cells longer than the column are wrapped into several lines.
+ * 
+ * The line breaks of all cells are computed first and kept as views into the values, so the
+ * text is scanned once and nothing is copied until it is placed into the row. The row is as high
+ * as its cell with the most lines, every line is a copy of the row template with the lines
+ * of the cells right-justified into their slots.
+ * 
+ * @tparam T The type of data stored in the array.
+ * @param state The state of the render.
+ * @param start_index The starting index of the row in the data array.
+ * @param cell_count The number of cells to print in the row, the remaining columns are left blank.
+ */
+template <Plottable T>
+void Plotter<T>::print_wrapped_row(RenderState& state, std::size_t start_index, std::size_t cell_count) const {
+    PLOTTER_STATS_ADD(state, cells_formatted, cell_count);
+    const std::size_t column_width = state.column_width;
+    const std::size_t* cell_offsets = _cell_offsets.data() + state.first_column;
+    std::array<char, cell_buffer_size> buffer;
+
+    // cell j owns the lines [cell_lines[j], cell_lines[j + 1])
+    std::pmr::vector<std::string_view>& lines = state.wrapped_lines;
+    std::pmr::vector<std::size_t>& cell_lines = state.wrapped_cells;
+    lines.clear();
+    cell_lines.assign(1, 0);
+
+    std::size_t height = 1;
+    for (std::size_t j = 0; j < cell_count; j++) {
+        std::string_view text = format_cell(value_at(state, start_index + cell_offsets[j]), buffer, state.engine);
+        if (text.length() <= column_width) {
+            lines.push_back(text);
+        }
+        else {
+            std::size_t position = 0;
+            do {
+                std::string_view line;
+                position = plotter_detail::wrap_line(text, position, column_width, line);
+                lines.push_back(line);
+            } while (position < text.length());
+        }
+        cell_lines.push_back(lines.size());
+        height = std::max(height, cell_lines[j + 1] - cell_lines[j]);
+    }
+
+    for (std::size_t k = 0; k < height; k++) {
+        char* slot_end = state.table.append(state.row_template) + 1 + column_width;
+        for (std::size_t j = 0; j < cell_count; j++) {
+            if (cell_lines[j] + k < cell_lines[j + 1]) {
+                std::string_view line = lines[cell_lines[j] + k];
+                std::memcpy(slot_end - line.length(), line.data(), line.length());
+            }
+            slot_end += column_width + 1;
+        }
+    }
+}
+
+/**
+ * @brief Formats a value the way it is displayed in a cell.
+ * 
+ * Numbers are converted by std::to_chars, floating point values in fixed notation
+ * with _precision decimal places. char is shown as the character, bool as 1 or 0,
+ * like a stream shows them. signed char and unsigned char are int8_t and uint8_t, they are
+ * shown as numbers like the other integers. Strings are returned as they are and other types are formatted
+ * by their CellFormatter. A custom value which does not fit the buffer is cut to the buffer.
+ * A floating point value whose fixed notation does not fit the buffer is shown in the
+ * general notation of format_plain(), the Stream engine does the same.
+ * No stream state or locale is involved, so concurrent renders share nothing but the data.
+ * The Stream engine formats the value by format_stream() instead.
+ * 
+ * @tparam T The type of the value.
+ * @param value The value to be formatted.
+ * @param buffer The buffer the number is written to.
+ * @param engine The engine which formats the value.
+ * @return The text of the value, it refers to the buffer or to the value itself.
+ */
+template <Plottable T>
+std::string_view Plotter<T>::format_cell(const T& value, std::span<char> buffer, CellEngine engine) const {
+    if (engine == CellEngine::Stream) {
+        return format_stream(value, buffer, true);
+    }
+
+    char* first = buffer.data();
+    char* last = buffer.data() + buffer.size();
+
+    if constexpr (std::is_same_v<T, bool>) {
+        return value ? "1" : "0";
+    }
+    else if constexpr (std::is_same_v<T, char>) {
+        buffer[0] = static_cast<char>(value);
+        return std::string_view(first, 1);
+    }
+    else if constexpr (std::is_floating_point_v<T>) {
+        std::to_chars_result result = std::to_chars(first, last, value, std::chars_format::fixed, _precision);
+        if (result.ec != std::errc()) {
+            return format_plain(value, buffer);
+        }
+        return localize(std::string_view(first, result.ptr - first), buffer);
+    }
+    else if constexpr (std::is_same_v<T, wchar_t> || std::is_same_v<T, char8_t> || std::is_same_v<T, char16_t> || std::is_same_v<T, char32_t>) {
+        // wide character types have no std::to_chars overload, they are shown as their code
+        using Code = std::conditional_t<std::is_signed_v<T>, long long, unsigned long long>;
+        return std::string_view(first, std::to_chars(first, last, static_cast<Code>(value)).ptr - first);
+    }
+    else if constexpr (std::is_integral_v<T>) {
+        static_assert(std::numeric_limits<T>::digits10 + 2 < cell_buffer_size, "Plotter: every integer has to fit the cell buffer.");
+        return localize(std::string_view(first, std::to_chars(first, last, value).ptr - first), buffer);
+    }
+    else if constexpr (CellText<T>) {
+        return std::string_view(value);
+    }
+    else {
+        std::to_chars_result result = CellFormatter<T>::format(first, last, value);
+        return std::string_view(first, result.ec == std::errc() ? result.ptr - first : buffer.size());
+    }
+}
+
+/**
+ * @brief Formats a value of a cell through the value cache of its column.
+ * 
+ * The cache of a column is direct-mapped, a value is looked up in the one slot its hash selects.
+ * A hit returns the stored text, a miss formats the value and stores it in the slot
+ * unless the text is too long for the slot. After value_cache_probe lookups a column whose hit rate
+ * is below value_cache_min_hit_percent stops using its cache, so columns of distinct values pay
+ * for the cache only at the start of the render. Without the cache the value is just formatted.
+ * 
+ * @tparam T The type of the value.
+ * @param state The state of the render.
+ * @param column The index of the column in the page.
+ * @param value The value to be formatted.
+ * @param buffer The buffer the number is written to.
+ * @return The text of the value, it refers to the buffer, the cache or the value itself.
+ */
+template <Plottable T>
+std::string_view Plotter<T>::format_cached(RenderState& state, std::size_t column, const T& value, std::span<char> buffer) const {
+    if constexpr (plotter_detail::is_number_v<T>) {
+        if (state.value_cache && state.cache_columns[column].enabled) {
+            plotter_detail::ValueCacheColumn& cache = state.cache_columns[column];
+            plotter_detail::CachedValue<T>& slot = state.cached_values[column * plotter_detail::value_cache_slots + plotter_detail::value_cache_slot(value)];
+            cache.lookups++;
+            if (slot.length != 0 && plotter_detail::same_number(slot.value, value)) {
+                cache.hits++;
+                return std::string_view(slot.text.data(), slot.length);
+            }
+
+            std::string_view text = format_cell(value, buffer, state.engine);
+            if (text.length() <= slot.text.size()) {
+                slot.value = value;
+                slot.length = static_cast<std::uint8_t>(text.length());
+                std::memcpy(slot.text.data(), text.data(), text.length());
+            }
+
+            // the hit rate only falls on a miss, so it is checked here
+            if (cache.lookups >= plotter_detail::value_cache_probe && cache.hits * 100 < cache.lookups * plotter_detail::value_cache_min_hit_percent) {
+                cache.enabled = false;
+            }
+            return text;
+        }
+    }
+    return format_cell(value, buffer, state.engine);
+}
+
+/**
+ * @brief Formats a value the way a default formatted stream prints it.
+ * 
+ * This is the text of values which are too long for their cell. Floating point values use
+ * the general notation with six significant digits, like std::ostream without std::fixed.
+ * 
+ * @tparam T The type of the value.
+ * @param value The value to be formatted.
+ * @param buffer The buffer the number is written to.
+ * @param engine The engine which formats the value.
+ * @return The text of the value, it refers to the buffer or to the value itself.
+ */
+template <Plottable T>
+std::string_view Plotter<T>::format_plain(const T& value, std::span<char> buffer, CellEngine engine) const {
+    if (engine == CellEngine::Stream) {
+        return format_stream(value, buffer, false);
+    }
+
+    if constexpr (std::is_floating_point_v<T>) {
+        std::to_chars_result result = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value, std::chars_format::general, 6);
+        return localize(std::string_view(buffer.data(), result.ptr - buffer.data()), buffer);
+    }
+    else {
+        return format_cell(value, buffer);
+    }
+}
+
+/**
+ * @brief Formats a value by a std::ostringstream, the reference for the other engines.
+ * 
+ * The stream uses the global locale like the original implementation. Strings are returned
+ * as they are and types which cannot be written to a stream are formatted by the ToChars engine.
+ * 
+ * @tparam T The type of the value.
+ * @param value The value to be formatted.
+ * @param buffer The buffer the text is copied to, a longer fixed text is replaced by the default one.
+ * @param fixed Whether the value is written with std::fixed and _precision or with the stream defaults.
+ * @return The text of the value, it refers to the buffer or to the value itself.
+ */
+template <Plottable T>
+std::string_view Plotter<T>::format_stream(const T& value, std::span<char> buffer, bool fixed) const {
+    if constexpr (CellText<T>) {
+        return std::string_view(value);
+    }
+    else if constexpr (requires(std::ostream& stream) { stream << value; }) {
+        std::ostringstream stream;
+        if (fixed) {
+            stream << std::setprecision(_precision) << std::fixed;
+        }
+        if constexpr (std::is_same_v<T, signed char> || std::is_same_v<T, unsigned char>) {
+            // a stream writes 8-bit integers as characters
+            stream << static_cast<int>(value);
+        }
+        else {
+            stream << value;
+        }
+        std::string text = std::move(stream).str();
+        if (fixed && text.length() > buffer.size()) {
+            return format_stream(value, buffer, false);
+        }
+        std::size_t length = std::min(text.length(), buffer.size());
+        std::memcpy(buffer.data(), text.data(), length);
+        if constexpr (plotter_detail::is_number_v<T>) {
+            return localize(std::string_view(buffer.data(), length), buffer);
+        }
+        return std::string_view(buffer.data(), length);
+    }
+    else {
+        return fixed ? format_cell(value, buffer) : format_plain(value, buffer);
+    }
+}
+
+/**
+ * @brief Applies the number format to a number formatted at the start of the buffer.
+ * 
+ * @tparam T The type of data in the table.
+ * @param text The number, it starts at the beginning of the buffer.
+ * @param buffer The buffer holding the number, separators are inserted in place.
+ * @return The localized number.
+ */
+template <Plottable T>
+std::string_view Plotter<T>::localize(std::string_view text, std::span<char> buffer) const {
+    if (!_localized) {
+        return text;
+    }
+    return std::string_view(buffer.data(), plotter_detail::localize_number(buffer, text.length(), _number_format));
+}
+
+/**
+ * @brief Returns the exact number of bytes get_table() produces with the given options.
+ * 
+ * The frame, the headers and the rows without too long values have a fixed size, which is
+ * computed from the table width and the number of columns. Only cells which may be too long
+ * for their column are inspected, see content_size().
+ * 
+ * @tparam T The type of data in the table.
+ * @param options The options of the render, only the row window is used.
+ * @return The size of the rendered table in bytes.
+ * @throws std::length_error If the table width is too small for the name or the column names.
+ */
+template <Plottable T>
+std::size_t Plotter<T>::rendered_size(const RenderOptions& options) const {
+    RenderState state = make_render_state(options);
+    validate_layout_throw_exception(state);
+
+    std::size_t size = frame_size(state);
+    for (std::size_t first_column = 0; first_column < _shown_cols; first_column += state.page_columns) {
+        select_page(state, first_column);
+        size += content_size(state);
+    }
+    return size;
+}
+
+/**
+ * @brief Checks that the name and the column names fit the table and throws an exception if they do not.
+ * 
+ * @tparam T The type of data in the table.
+ * @param state The state of the render, provides the column width.
+ * @throws std::length_error If the table width is too small for the name or the column names.
+ */
+template <Plottable T>
+void Plotter<T>::validate_layout_throw_exception(const RenderState& state) const {
+    // the last page is the narrowest one
+    std::size_t last_page_columns = _shown_cols - (_shown_cols - 1) / state.page_columns * state.page_columns;
+    if (page_width(state.page_columns, last_page_columns, state.column_width) < _name.length() + 2) {
+        throw std::length_error("Plotter: table width is too small for the content.");
+    }
+    for (std::size_t column : _shown_columns) {
+        if (_column_names[column].length() > state.column_width) {
+            throw std::length_error("Plotter: table width is too small for the content.");
+        }
+    }
+}
+
+/**
+ * @brief Calculates the size of the table without the growth caused by too long values.
+ * 
+ * @tparam T The type of data in the table.
+ * @param state The state of the render, provides the row window and the pages.
+ * @return The size of the frame, the headers and the rows in bytes.
+ */
+template <Plottable T>
+std::size_t Plotter<T>::frame_size(const RenderState& state) const {
+    std::size_t rows = state.last_row - state.first_row;
+
+    // headers, rows and closing line of every page, trailing newline
+    std::size_t size = 1;
+    for (std::size_t first_column = 0; first_column < _shown_cols; first_column += state.page_columns) {
+        std::size_t column_count = std::min(state.page_columns, _shown_cols - first_column);
+        std::size_t frame_width = page_width(state.page_columns, column_count, state.column_width);
+        size += header_size(column_count, state.column_width, frame_width) + rows * row_size(column_count, state.column_width) + frame_width + 1;
+    }
+    return size;
+}
+
+/**
+ * @brief Calculates the size of the table header and the columns header.
+ * 
+ * @tparam T The type of data in the table.
+ * @param column_count The number of columns of the page.
+ * @param column_width The width of the columns.
+ * @param frame_width The width of the frame and the title of the page.
+ * @return The size of everything in front of the first row in bytes.
+ */
+template <Plottable T>
+std::size_t Plotter<T>::header_size(std::size_t column_count, std::size_t column_width, std::size_t frame_width) const {
+    std::size_t line_size = frame_width + 1;
+
+    // leading newline, framed name, columns header and its closing line
+    return 1 + 3 * line_size + row_size(column_count, column_width) + line_size;
+}
+
+/**
+ * @brief Calculates the size of a row without too long values.
+ * 
+ * @tparam T The type of data in the table.
+ * @param column_count The number of columns of the page.
+ * @param column_width The width of the columns.
+ * @return The size of a row in bytes.
+ */
+template <Plottable T>
+std::size_t Plotter<T>::row_size(std::size_t column_count, std::size_t column_width) const {
+    return column_count * (column_width + 1) + 2;
+}
+
+/**
+ * @brief Calculates the width of the frame and the title of a page.
+ * 
+ * An unpaged table is framed at the table width. Pages are framed at the width of their rows,
+ * so a last page with fewer columns gets a narrower frame.
+ * 
+ * @tparam T The type of data in the table.
+ * @param page_columns The number of columns per page.
+ * @param column_count The number of columns of the page.
+ * @param column_width The width of the columns.
+ * @return The width of the frame without the newline.
+ */
+template <Plottable T>
+std::size_t Plotter<T>::page_width(std::size_t page_columns, std::size_t column_count, std::size_t column_width) const {
+    return page_columns < _shown_cols ? row_size(column_count, column_width) - 1 : _table_width;
+}
+
+/**
+ * @brief Calculates the bytes which the rows of a render add to their fixed size.
+ * 
+ * A row grows only by values which are too long for their cell: the value is reported after the row
+ * and, if even the default value does not fit the column, the cell itself is wider than the column.
+ * Integers which always fit are never inspected. Floating point values are compared against the
+ * largest magnitude which surely fits and only values above it are formatted.
+ * The Stream engine formats every value, so the size is exact for the engine being verified.
+ * Wrapped text cells make their row higher by whole lines instead.
+ * 
+ * @tparam T The type of data in the table.
+ * @param state The state of the render, provides the row window.
+ * @return The number of additional bytes.
+ */
+template <Plottable T>
+std::size_t Plotter<T>::content_size(const RenderState& state) const {
+    if constexpr (CellText<T>) {
+        if (state.wrap_cells && state.column_width != 0) {
+            // wrapped cells add whole lines to their row, nothing is reported after it
+            const std::size_t* cell_offsets = _cell_offsets.data() + state.first_column;
+            std::size_t size = 0;
+            for (std::size_t i = state.first_row; i < state.last_row; i++) {
+                std::size_t start_index = row_start_index(i);
+                std::size_t cell_count = page_cell_count(state, i);
+                std::size_t height = 1;
+                for (std::size_t j = 0; j < cell_count; j++) {
+                    std::string_view text(value_at(state, start_index + cell_offsets[j]));
+                    std::size_t line_count = 0;
+                    for (std::size_t position = 0; text.length() > state.column_width && position < text.length(); line_count++) {
+                        std::string_view line;
+                        position = plotter_detail::wrap_line(text, position, state.column_width, line);
+                    }
+                    height = std::max(height, line_count);
+                }
+                size += (height - 1) * row_size(state.column_count, state.column_width);
+            }
+            return size;
+        }
+    }
+
+    if constexpr (std::is_integral_v<T>) {
+        std::size_t separators = _number_format.thousands_separator != '\0' ? std::numeric_limits<T>::digits10 / 3u : 0;
+        if (std::numeric_limits<T>::digits10 + 2u + separators <= state.column_width && state.engine == CellEngine::ToChars) {
+            return 0;
+        }
+    }
+
+    std::array<char, cell_buffer_size> buffer;
+    std::size_t default_size = format_cell(T(), buffer, state.engine).length();
+    std::size_t slot_growth = default_size > state.column_width ? default_size - state.column_width : 0;
+
+    if constexpr (CellText<T>) {
+        if (_codes != nullptr) {
+            // the report of a too long dictionary entry is measured once, the cells only add them up
+            std::pmr::vector<std::size_t> report_sizes(_dictionary.size(), 0, state.memory_resource);
+            for (std::size_t k = 0; k < _dictionary.size(); k++) {
+                if (format_cell(_dictionary[k], buffer, state.engine).length() > state.column_width) {
+                    // "\n\ncell: " and " value: "
+                    report_sizes[k] = 16 + format_plain(_dictionary[k], buffer, state.engine).length() + slot_growth;
+                }
+            }
+
+            std::size_t size = 0;
+            const std::size_t* cell_offsets = _cell_offsets.data() + state.first_column;
+            for (std::size_t i = state.first_row; i < state.last_row; i++) {
+                std::size_t start_index = row_start_index(i);
+                std::size_t cell_count = page_cell_count(state, i);
+                for (std::size_t j = 0; j < cell_count; j++) {
+                    std::size_t report_size = report_sizes[_codes[start_index + cell_offsets[j]]];
+                    if (report_size != 0) {
+                        std::array<char, 24> index_buffer;
+                        size += report_size + (std::to_chars(index_buffer.data(), index_buffer.data() + index_buffer.size(), state.first_column + j).ptr - index_buffer.data());
+                    }
+                }
+            }
+            return size;
+        }
+    }
+
+    // magnitude below which a value keeps its sign and integer digits inside the column after rounding
+    double fit_limit = 0.0;
+    if constexpr (std::is_floating_point_v<T>) {
+        std::ptrdiff_t integer_digits = static_cast<std::ptrdiff_t>(state.column_width) - static_cast<std::ptrdiff_t>(_precision) - 2;
+        if (_number_format.thousands_separator != '\0') {
+            // d digits take d + (d - 1) / 3 characters with separators
+            integer_digits -= integer_digits / 4;
+        }
+        if (integer_digits >= 1 && state.engine == CellEngine::ToChars) {
+            fit_limit = std::pow(10.0, static_cast<double>(std::min<std::ptrdiff_t>(integer_digits, 300))) - 1.0;
+        }
+    }
+
+    std::size_t size = 0;
+    const std::size_t* cell_offsets = _cell_offsets.data() + state.first_column;
+    for (std::size_t i = state.first_row; i < state.last_row; i++) {
+        std::size_t start_index = row_start_index(i);
+        std::size_t cell_count = page_cell_count(state, i);
+        for (std::size_t j = 0; j < cell_count; j++) {
+            const T& value = value_at(state, start_index + cell_offsets[j]);
+
+            if constexpr (std::is_floating_point_v<T>) {
+                if (std::abs(value) < fit_limit) {
+                    continue;
+                }
+            }
+            if (format_cell(value, buffer, state.engine).length() <= state.column_width) {
+                continue;
+            }
+
+            std::array<char, 24> index_buffer;
+            std::size_t index_size = std::to_chars(index_buffer.data(), index_buffer.data() + index_buffer.size(), state.first_column + j).ptr - index_buffer.data();
+
+            // "\n\ncell: " and " value: "
+            size += 16 + index_size + format_plain(value, buffer, state.engine).length() + slot_growth;
+        }
+    }
+    return size;
+}
+
+/**
+ * @brief Validates the inputs of the Plotter class and throws an exception if they are invalid.
+ * 
+ * This function checks if the data pointer is null and if the column names vector is empty.
+ * If either of these conditions is true, it prints an error message to the standard error stream
+ * and throws an std::invalid_argument exception with an appropriate error message.
+ * 
+ * @tparam T The type of data stored in the Plotter.
+ * @throws std::invalid_argument If the data pointer is null or the column names vector is empty.
+ */
+template <Plottable T>
+void Plotter<T>::validate_inputs_throw_exception() {
+    if (_data == nullptr && _codes == nullptr) {
+        throw std::invalid_argument("Plotter: data pointer cannot be null.");
+    }
+
+    if (_column_names.empty()) {
+        throw std::invalid_argument("Plotter: column names vector cannot be empty.");
+    }
+
+    if (_table_width == 0) {
+        throw std::invalid_argument("Plotter: table width cannot be zero.");
+    }
+
+    if (_size == 0) {
+        throw std::invalid_argument("Plotter: size cannot be zero.");
+    }
+}
+
+/**
+ * @brief Calculates the column width for a table.
+ * 
+ * This function calculates the width of each column in a table based on the total table width and the number of columns.
+ * 
+ * @param table_width The total width of the table.
+ * @param cols The number of columns in the table.
+ * @return The calculated column width.
+ */
+template <Plottable T>
+std::size_t Plotter<T>::calculate_column_width(std::size_t table_width, std::size_t cols) const {
+    return table_width > cols + 1 ? (table_width - (cols + 1)) / cols : 0;
+}
+
+/**
+ * @brief Calculates the number of rows needed to display a given number of elements in a specified number of columns.
+ * 
+ * A size which is not a multiple of the column count gets one more, partial row,
+ * so no element is left out.
+ * 
+ * @tparam T The type of the elements.
+ * @param size The total number of elements.
+ * @param column_count The number of columns.
+ * @return The number of rows needed to display the elements.
+ */
+template <Plottable T>
+std::size_t Plotter<T>::calculate_rows(std::size_t size, std::size_t column_count) {
+    return size / column_count + (size % column_count != 0 ? 1 : 0);
+}
+
+/**
+ * @brief Calculates the number of leading rows which have a value in every column.
+ * 
+ * In RowMajor arrangement only the last row can be partial. In ColumnMajor arrangement
+ * the columns are filled from top to bottom with _rows values each, so the last used
+ * column can be short and the columns after it stay empty.
+ * 
+ * @tparam T The type of data in the table.
+ * @return The number of full rows.
+ */
+template <Plottable T>
+std::size_t Plotter<T>::calculate_full_rows() const {
+    if (_data_arrangement == DataArrangement::RowMajor) {
+        return _size / _cols;
+    }
+    std::size_t leading_cells = (_cols - 1) * _rows;
+    return _size > leading_cells ? std::min(_rows, _size - leading_cells) : 0;
+}
+
+/**
+ * @brief Calculates the number of cells a row has, the missing cells are always the trailing ones.
+ * 
+ * @tparam T The type of data in the table.
+ * @param row The index of the row.
+ * @return The number of cells with a value in the row.
+ */
+template <Plottable T>
+std::size_t Plotter<T>::row_cell_count(std::size_t row) const {
+    if (_data_arrangement == DataArrangement::RowMajor) {
+        return std::min(_cols, _size - row * _cols);
+    }
+    return std::min(_cols, (_size - row + _rows - 1) / _rows);
+}
+
+/**
+ * @brief Calculates the number of shown cells a row has, the missing cells are always the trailing ones.
+ * 
+ * @tparam T The type of data in the table.
+ * @param row The index of the row.
+ * @return The number of shown columns with a value in the row.
+ */
+template <Plottable T>
+std::size_t Plotter<T>::shown_cell_count(std::size_t row) const {
+    std::size_t cell_count = row_cell_count(row);
+    return static_cast<std::size_t>(std::lower_bound(_shown_columns.begin(), _shown_columns.end(), cell_count) - _shown_columns.begin());
+}
+
+/**
+ * @brief Calculates the number of cells a row has on the page of the render.
+ * 
+ * @tparam T The type of data in the table.
+ * @param state The state of the render, provides the page.
+ * @param row The index of the row.
+ * @return The number of cells with a value on the page.
+ */
+template <Plottable T>
+std::size_t Plotter<T>::page_cell_count(const RenderState& state, std::size_t row) const {
+    if (row < _full_rows) {
+        return state.column_count;
+    }
+    std::size_t shown_cells = shown_cell_count(row);
+    return shown_cells > state.first_column ? std::min(state.column_count, shown_cells - state.first_column) : 0;
+}
+
+/**
+ * @brief Returns the value of a cell, dictionary-encoded cells are looked up by their code.
+ * 
+ * @tparam T The type of data in the table.
+ * @param state The state of the render, provides the data being rendered.
+ * @param index The index of the cell in the data array.
+ * @return The value of the cell.
+ */
+template <Plottable T>
+const T& Plotter<T>::value_at(const RenderState& state, std::size_t index) const {
+    if constexpr (CellText<T>) {
+        if (_codes != nullptr) {
+            return _dictionary[_codes[index]];
+        }
+    }
+    return state.data[index];
+}
+
+/**
+ * @brief Calculates the index of the first cell of a row in the data array.
+ * 
+ * @tparam T The type of data in the table.
+ * @param row The index of the row.
+ * @return The index of the first cell of the row.
+ */
+template <Plottable T>
+std::size_t Plotter<T>::row_start_index(std::size_t row) const {
+    return _data_arrangement == DataArrangement::RowMajor ? row * _cols : row;
+}
+
+/**
+ * @brief Prints a horizontal line with '+' at the beginning and end.
+ * 
+ * This method is used to print a horizontal line in the table with '+' at the beginning and end.
+ * The length of the line is the width of the frame of the current page.
+ * 
+ * @param state The state of the render.
+ */
+template <Plottable T>
+void Plotter<T>::print_endline(RenderState& state) const {
+    state.table += "+";
+    print_repeated(state, '-', static_cast<std::ptrdiff_t>(state.frame_width) - 2);
+    state.table += "+\n";
+}
+
+/**
+ * @brief Prints a character repeated count times.
+ * 
+ * The characters are appended in place, without building a temporary string.
+ * 
+ * @tparam T The type of data in the table.
+ * @param state The state of the render.
+ * @param character The character to print.
+ * @param count The number of repetitions.
+ * @throws std::length_error If the count is negative, which happens when the content does not fit the table width.
+ */
+template <Plottable T>
+void Plotter<T>::print_repeated(RenderState& state, char character, std::ptrdiff_t count) const {
+    if (count < 0) {
+        throw std::length_error("Plotter: table width is too small for the content.");
+    }
+    state.table.append(static_cast<std::size_t>(count), character);
+}
+
+/**
+ * @brief Prints the table data as a heatmap.
+ * 
+ * Every cell is drawn as a single colored block character. Matrices wider than the table
+ * are downsampled by block-averaging, so the heatmap always fits into `_table_width`.
+ * 
+ * @tparam T The type of data in the table.
+ * @param palette The terminal color mode used for the cells.
+ */
+template <Plottable T>
+void Plotter<T>::print_heatmap(HeatmapPalette palette) const {
+    std::cout << get_heatmap(palette);
+}
+
+/**
+ * @brief Get the heatmap as a string.
+ * 
+ * This function generates the heatmap by printing the table header, the heatmap content and the closing line.
+ * 
+ * @tparam T The type of data in the table.
+ * @param palette The terminal color mode used for the cells.
+ * @param options The options of the render.
+ * @return std::string The generated heatmap as a string.
+ */
+template <Plottable T>
+std::string Plotter<T>::get_heatmap(HeatmapPalette palette, const RenderOptions& options) const {
+    std::string table;
+    RenderState state = make_render_state(options, TableWriter(table));
+    try {
+        {
+            PLOTTER_STATS_TIMER(state, frame_time);
+            plotter_detail::TraceScope trace(state.trace, "table_header");
+            print_table_header(state);
+        }
+        PLOTTER_STATS_TIMER(state, format_time);
+        plotter_detail::TraceScope trace(state.trace, "heatmap", state.first_row, state.last_row - state.first_row);
+        print_heatmap_content(state, palette);
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error printing heatmap: " + _name + "\n" << e.what() << "\n";
+    }
+    catch (...) {
+        std::cerr << "Error: An unknown error occurred while printing the heatmap: " + _name + "\n";
+    }
+
+    state.table += "\n";
+    release_transient_memory(state);
+    std::size_t written = state.table.finish();
+    PLOTTER_STATS_ADD(state, allocations, state.table.allocations());
+    PLOTTER_STATS_ADD(state, bytes_emitted, written);
+    return table;
+}
+
+
+/**
+ * @brief Points the table to its data after the data has grown or moved.
+ * 
+ * The column names and options stay, the rows are recalculated for the new size.
+ * 
+ * @tparam T The type of data in the table.
+ * @param data Pointer to the data array.
+ * @param size The size of the data array.
+ * @throws std::invalid_argument If the data pointer is null or the size is zero.
+ * @throws std::logic_error If the table is dictionary-encoded.
+ */
+template <Plottable T>
+void Plotter<T>::set_data(T* data, std::size_t size) {
+    if (_codes != nullptr) {
+        throw std::logic_error("Plotter: dictionary-encoded data cannot be replaced.");
+    }
+    if (data == nullptr) {
+        throw std::invalid_argument("Plotter: data pointer cannot be null.");
+    }
+    if (size == 0) {
+        throw std::invalid_argument("Plotter: size cannot be zero.");
+    }
+    _data = data;
+    _size = size;
+    _rows = calculate_rows(_size, _cols);
+    _full_rows = calculate_full_rows();
+    update_layout();
+}
+
+/**
+ * @brief Prints the rows added since the last call for the cursor to the sink.
+ * 
+ * @tparam T The type of data in the table.
+ * @param sink The stream the rows are written to.
+ * @param cursor The progress of the output.
+ * @param options The options of the render.
+ */
+template <Plottable T>
+void Plotter<T>::print_new_rows(std::ostream& sink, AppendCursor& cursor, const RenderOptions& options) const {
+    std::string rows = get_new_rows(cursor, options);
+    PLOTTER_STATS_TIMER(options, sink_time);
+    plotter_detail::TraceScope trace(options.trace, "sink_write");
+    sink.write(rows.data(), static_cast<std::streamsize>(rows.size()));
+}
+
+/**
+ * @brief Get the rows added since the last call for the cursor as a string.
+ * 
+ * The first call also returns the table header and the columns header. Only complete rows
+ * are emitted, a partial last row waits until it is complete or the table is finalized,
+ * so the cost of a call depends on the new rows only. The closing line is left to finalize().
+ * Renders with a cursor are RowMajor and unpaged, as other arrangements and pages
+ * change rows which are already emitted. Other arrangements and a paged_column_width
+ * are reported as errors and nothing is returned.
+ * 
+ * @tparam T The type of data in the table.
+ * @param cursor The progress of the output, advanced past the returned rows.
+ * @param options The options of the render, the row window is ignored and paging is not allowed.
+ * @return std::string The new part of the table.
+ */
+template <Plottable T>
+std::string Plotter<T>::get_new_rows(AppendCursor& cursor, const RenderOptions& options) const {
+    return render_appended(cursor, options, false);
+}
+
+/**
+ * @brief Get the rest of a table rendered with a cursor, the partial last row and the closing line.
+ * 
+ * @tparam T The type of data in the table.
+ * @param cursor The progress of the output, no rows can be added for it afterwards.
+ * @param options The options of the render, the row window is ignored and paging is not allowed.
+ * @return std::string The end of the table.
+ */
+template <Plottable T>
+std::string Plotter<T>::finalize(AppendCursor& cursor, const RenderOptions& options) const {
+    return render_appended(cursor, options, true);
+}
+
+/**
+ * @brief Renders the part of a table which follows the cursor.
+ * 
+ * @tparam T The type of data in the table.
+ * @param cursor The progress of the output.
+ * @param options The options of the render.
+ * @param final Whether the partial row and the closing line end the table.
+ * @return std::string The rendered part.
+ */
+template <Plottable T>
+std::string Plotter<T>::render_appended(AppendCursor& cursor, const RenderOptions& options, bool final) const {
+    std::string table;
+    RenderOptions window = options;
+    window.first_row = cursor.emitted_rows;
+    window.row_count = (final ? _rows : _full_rows) - std::min(cursor.emitted_rows, final ? _rows : _full_rows);
+    RenderState state = make_render_state(window, TableWriter(table));
+    try {
+        if (cursor.finalized) {
+            throw std::logic_error("Plotter: the table of the cursor is already finalized.");
+        }
+        if (_data_arrangement != DataArrangement::RowMajor) {
+            throw std::logic_error("Plotter: rows can be appended to RowMajor tables only.");
+        }
+        if (options.paged_column_width != 0) {
+            throw std::logic_error("Plotter: rows cannot be appended to paged tables.");
+        }
+        validate_layout_throw_exception(state);
+
+        select_page(state, 0);
+        if (!cursor.header_emitted) {
+            PLOTTER_STATS_TIMER(state, frame_time);
+            {
+                plotter_detail::TraceScope trace(state.trace, "table_header");
+                print_table_header(state);
+            }
+            plotter_detail::TraceScope trace(state.trace, "columns_header", state.first_column, state.column_count);
+            print_columns_header(state);
+            cursor.header_emitted = true;
+        }
+
+        print_rows(state);
+        cursor.emitted_rows = state.last_row;
+
+        if (final) {
+            PLOTTER_STATS_TIMER(state, frame_time);
+            print_endline(state);
+            state.table += "\n";
+            cursor.finalized = true;
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error printing table: " + _name + "\n" << e.what() << "\n";
+    }
+    catch (...) {
+        std::cerr << "Error: An unknown error occurred while printing the table: " + _name + "\n";
+    }
+
+    release_transient_memory(state);
+    std::size_t written = state.table.finish();
+    PLOTTER_STATS_ADD(state, allocations, state.table.allocations());
+    PLOTTER_STATS_ADD(state, bytes_emitted, written);
+    return table;
+}
+
+/**
+ * @brief Prints the diff of the table and another buffer of the same shape.
+ * 
+ * @tparam T The type of data in the table.
+ * @param other The data the table is compared to, laid out like the data of the table.
+ * @param diff The options of the diff.
+ */
+template <Plottable T>
+void Plotter<T>::print_diff(const T* other, DiffOptions diff) const requires std::equality_comparable<T> {
+    std::cout << get_diff(other, diff);
+}
+
+/**
+ * @brief Get the diff of the table and another buffer of the same shape as a string.
+ * 
+ * The data of the table is the old state, other the new one. All cells are compared in one pass
+ * over both buffers in storage order, which leaves a byte per cell telling whether it changed.
+ * The table is then rendered from the new data with the changed cells marked, in ChangedRows mode
+ * only the changed rows are rendered.
+ * 
+ * @tparam T The type of data in the table.
+ * @param other The data the table is compared to, laid out like the data of the table.
+ * @param diff The options of the diff.
+ * @param options The options of the render.
+ * @return std::string The generated diff as a string.
+ */
+template <Plottable T>
+std::string Plotter<T>::get_diff(const T* other, DiffOptions diff, const RenderOptions& options) const requires std::equality_comparable<T> {
+    std::string table;
+
+    // the cells are read from the new data
+    RenderState state = make_render_state(options, TableWriter(table));
+    state.data = other;
+    try {
+        if (other == nullptr) {
+            throw std::invalid_argument("Plotter: diff data pointer cannot be null.");
+        }
+        if (_codes != nullptr) {
+            throw std::logic_error("Plotter: diff requires data which is not dictionary-encoded.");
+        }
+
+        std::pmr::vector<unsigned char> changed(_size, state.memory_resource);
+        {
+            plotter_detail::TraceScope trace(state.trace, "compare");
+            plotter_detail::mark_changed(_data, other, _size, diff.epsilon, changed.data());
+        }
+        state.changed_cells = changed.data();
+        state.diff_mode = diff.mode;
+        render(state);
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error printing diff: " + _name + "\n" << e.what() << "\n";
+    }
+    catch (...) {
+        std::cerr << "Error: An unknown error occurred while printing the diff: " + _name + "\n";
+    }
+
+    state.table += "\n";
+    release_transient_memory(state);
+    std::size_t written = state.table.finish();
+    PLOTTER_STATS_ADD(state, allocations, state.table.allocations());
+    PLOTTER_STATS_ADD(state, bytes_emitted, written);
+    return table;
+}
+
+/**
+ * @brief Prints the heatmap cells and the closing line of the table.
+ * 
+ * The rows inside the window of the render are reduced to at most `_table_width - 2` columns
+ * by averaging square blocks of cells. Missing cells of partial rows are not counted,
+ * a block without any cell stays blank, like a block whose average is NaN or infinite.
+ * The averages are quantized to heat levels, which index the precomputed escape sequences.
+ * The escape sequence is emitted only when the level changes, otherwise just the glyph is appended.
+ * 
+ * @tparam T The type of data in the table.
+ * @param state The state of the render.
+ * @param palette The terminal color mode used for the cells.
+ * @throws std::logic_error If the data type is not arithmetic.
+ */
+template <Plottable T>
+void Plotter<T>::print_heatmap_content(RenderState& state, HeatmapPalette palette) const {
+    if constexpr (!std::is_arithmetic_v<T>) {
+        throw std::logic_error("Plotter: heatmap requires arithmetic data.");
+    }
+    else {
+        std::size_t width = _table_width > 2 ? _table_width - 2 : 1;
+        std::size_t factor = (_cols + width - 1) / width;
+        std::size_t heat_cols = (_cols + factor - 1) / factor;
+        std::size_t rows = state.last_row - state.first_row;
+        std::size_t heat_rows = (rows + factor - 1) / factor;
+
+        // block sums and cell counts, the data is walked in storage order
+        std::pmr::vector<double> heat(heat_rows * heat_cols, 0.0, state.memory_resource);
+        std::pmr::vector<std::size_t> counts(heat_rows * heat_cols, 0, state.memory_resource);
+        if (_data_arrangement == DataArrangement::RowMajor) {
+            for (std::size_t i = 0; i < rows; i++) {
+                double* heat_row = &heat[(i / factor) * heat_cols];
+                std::size_t* count_row = &counts[(i / factor) * heat_cols];
+                const T* data_row = &state.data[(state.first_row + i) * _cols];
+                std::size_t cell_count = state.first_row + i < _full_rows ? _cols : row_cell_count(state.first_row + i);
+                for (std::size_t j = 0; j < cell_count; j++) {
+                    heat_row[j / factor] += static_cast<double>(data_row[j]);
+                    count_row[j / factor]++;
+                }
+            }
+        }
+        else {
+            for (std::size_t j = 0; j < _cols && j * _rows + state.first_row < _size; j++) {
+                double* heat_col = &heat[j / factor];
+                std::size_t* count_col = &counts[j / factor];
+                const T* data_col = &state.data[j * _rows + state.first_row];
+                std::size_t cell_count = std::min(rows, _size - j * _rows - state.first_row);
+                for (std::size_t i = 0; i < cell_count; i++) {
+                    heat_col[(i / factor) * heat_cols] += static_cast<double>(data_col[i]);
+                    count_col[(i / factor) * heat_cols]++;
+                }
+            }
+        }
+
+        // block averages and value range, non-finite blocks and blocks without cells stay blank
+        double min = std::numeric_limits<double>::infinity();
+        double max = -std::numeric_limits<double>::infinity();
+        for (std::size_t i = 0; i < heat.size(); i++) {
+            double& value = heat[i];
+            value = counts[i] != 0 ? value / static_cast<double>(counts[i]) : std::numeric_limits<double>::quiet_NaN();
+            if (std::isfinite(value)) {
+                min = std::min(min, value);
+                max = std::max(max, value);
+            }
+            else {
+                value = std::numeric_limits<double>::quiet_NaN();
+            }
+        }
+
+        // a range too wide for a double is measured in halves
+        double range_factor = std::isfinite(max - min) ? 1.0 : 0.5;
+        double scale = max > min ? (plotter_detail::heatmap_levels - 1) / (max * range_factor - min * range_factor) : 0.0;
+
+        const plotter_detail::HeatmapLut& lut = plotter_detail::heatmap_lut(palette);
+        const std::string_view reset = "\x1b[0m";
+        const std::pmr::string padding(width - heat_cols, ' ', state.memory_resource);
+
+        std::pmr::string content(state.memory_resource);
+        content.reserve(heat_rows * (heat_cols * lut.escapes[0].size() + reset.size() + padding.size() + 3));
+        for (std::size_t i = 0; i < heat_rows; i++) {
+            content += "|";
+            std::size_t previous_level = plotter_detail::heatmap_levels;
+            for (std::size_t j = 0; j < heat_cols; j++) {
+                double value = heat[i * heat_cols + j];
+                if (std::isnan(value)) {
+                    content += reset;
+                    content += " ";
+                    previous_level = plotter_detail::heatmap_levels;
+                    continue;
+                }
+                double position = std::clamp((value * range_factor - min * range_factor) * scale, 0.0, static_cast<double>(plotter_detail::heatmap_levels - 1));
+                std::size_t level = lut.canonical_level[static_cast<std::size_t>(position)];
+                if (level == previous_level) {
+                    content += plotter_detail::heatmap_glyph;
+                }
+                else {
+                    content += lut.escapes[level];
+                    previous_level = level;
+                }
+            }
+            content += reset;
+            content += padding;
+            content += "|\n";
+        }
+
+        state.table += content;
+        print_endline(state);
+    }
+}
+
+
+/**
+ * @brief Renders many tables in parallel and writes them to the sink in the order of the specs.
+ * 
+ * The specs are processed in waves. Within a wave the workers claim chunks of consecutive tables
+ * from a shared counter, so fast workers take over the remaining work of slow ones. Every worker appends
+ * its tables to its own arena buffer, which is cleared but not released between waves. After each wave
+ * the chunks are written to the sink in order, one write per chunk. Every worker shows its tables
+ * through one reused Plotter, so a table costs no allocations once the buffers have grown.
+ * Tables which cannot be rendered are reported to the standard error stream and skipped.
+ * 
+ * @tparam T The type of data in the tables.
+ * @param specs The tables to render.
+ * @param sink The stream the tables are written to.
+ * @param threads The number of worker threads, zero selects the hardware concurrency.
+ * @param trace The recorder of the rendered chunks, the waits at the end of the waves and the sink writes, may be null.
+ */
+template <Plottable T>
+void Plotter<T>::render_all(std::span<const TableSpec<T>> specs, std::ostream& sink, unsigned int threads, RenderTrace* trace) {
+    if (specs.empty()) {
+        return;
+    }
+
+    std::size_t chunk_count = (specs.size() + plotter_detail::batch_chunk_size - 1) / plotter_detail::batch_chunk_size;
+    std::size_t worker_count = threads != 0 ? threads : std::max(1u, std::thread::hardware_concurrency());
+    worker_count = std::min(worker_count, chunk_count);
+    std::size_t wave_chunks = worker_count * plotter_detail::batch_chunks_per_wave;
+
+    std::vector<std::string> arenas(worker_count);
+    std::vector<std::unique_ptr<RenderArena>> render_arenas;
+    for (std::size_t worker = 0; worker < worker_count; worker++) {
+        render_arenas.push_back(std::make_unique<RenderArena>());
+    }
+    // every worker reuses one Plotter, so the names and layouts of its tables share their memory
+    std::vector<std::optional<Plotter<T>>> plotters(worker_count);
+    std::vector<plotter_detail::BatchChunk> chunks(wave_chunks);
+    std::atomic<std::size_t> next_chunk{ 0 };
+    std::size_t wave_begin = 0;
+    std::size_t wave_end = 0;
+    bool finished = false;
+
+    std::barrier wave_start(static_cast<std::ptrdiff_t>(worker_count));
+    std::barrier wave_done(static_cast<std::ptrdiff_t>(worker_count));
+
+    auto render_wave = [&](std::size_t worker) {
+        std::string& arena = arenas[worker];
+        arena.clear();
+        for (std::size_t chunk = next_chunk.fetch_add(1); chunk < wave_end; chunk = next_chunk.fetch_add(1)) {
+            std::size_t offset = arena.size();
+            std::size_t first = chunk * plotter_detail::batch_chunk_size;
+            std::size_t last = std::min(first + plotter_detail::batch_chunk_size, specs.size());
+            plotter_detail::TraceScope chunk_trace(trace, "tables", first, last - first);
+            std::optional<Plotter<T>>& plotter = plotters[worker];
+            for (std::size_t i = first; i < last; i++) {
+                const TableSpec<T>& spec = specs[i];
+                try {
+                    if (plotter.has_value()) {
+                        plotter->assign(spec);
+                    }
+                    else {
+                        plotter.emplace(spec.data, spec.name, spec.column_names, spec.table_width, spec.size, spec.data_arrangement);
+                    }
+                    plotter->set_memory_resource(render_arenas[worker].get());
+                    plotter->append_table(arena, RenderOptions());
+                }
+                catch (const std::exception& e) {
+                    std::cerr << "Error printing table: " + spec.name + "\n" + e.what() + "\n";
+                }
+            }
+            chunks[chunk - wave_begin] = { worker, offset, arena.size() - offset };
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(worker_count - 1);
+    for (std::size_t worker = 1; worker < worker_count; worker++) {
+        workers.emplace_back([&, worker]() {
+            while (true) {
+                {
+                    plotter_detail::TraceScope wait_trace(trace, "wave_start_wait");
+                    wave_start.arrive_and_wait();
+                }
+                if (finished) {
+                    return;
+                }
+                render_wave(worker);
+                plotter_detail::TraceScope wait_trace(trace, "wave_done_wait");
+                wave_done.arrive_and_wait();
+            }
+        });
+    }
+
+    // the calling thread works as worker zero and emits the output between the waves
+    for (wave_begin = 0; wave_begin < chunk_count; wave_begin = wave_end) {
+        wave_end = std::min(wave_begin + wave_chunks, chunk_count);
+        next_chunk.store(wave_begin);
+
+        wave_start.arrive_and_wait();
+        render_wave(0);
+        {
+            plotter_detail::TraceScope wait_trace(trace, "wave_done_wait");
+            wave_done.arrive_and_wait();
+        }
+
+        plotter_detail::TraceScope sink_trace(trace, "sink_write", wave_begin * plotter_detail::batch_chunk_size,
+            std::min(wave_end * plotter_detail::batch_chunk_size, specs.size()) - wave_begin * plotter_detail::batch_chunk_size);
+        for (std::size_t chunk = 0; chunk < wave_end - wave_begin; chunk++) {
+            const plotter_detail::BatchChunk& rendered = chunks[chunk];
+            sink.write(arenas[rendered.worker].data() + rendered.offset, static_cast<std::streamsize>(rendered.length));
+        }
+    }
+
+    finished = true;
+    wave_start.arrive_and_wait();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    sink.flush();
+}
@@ -1,301 +1,556 @@
 #include <string>
+#include <array>
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <system_error>
 #include "Plotter.hpp"
 
-/**
- * @brief Constructs a Plotter object.
- * 
- * @tparam T The type of data stored in the Plotter.
- * @param data Pointer to the data array.
- * @param name The name of the Plotter.
- * @param column_names Vector of column names.
- * @param table_width The width of the table.
- * @param size The size of the data array.
- * @param data_arrangement The arrangement of the data in the table.
- */
-template <typename T>
-Plotter<T>::Plotter(T* data, std::string name, std::vector<std::string> column_names, unsigned int table_width, unsigned int size, DataArrangement data_arrangement)
-    : _data(data), _data_arrangement(data_arrangement), _column_names(column_names), _name(name), _table_width(table_width), _size(size) {
-    validate_inputs_throw_exception();
-    _cols = column_names.size();
-    _rows = calculate_rows(size, _cols);
-    _column_width = calculate_column_width(table_width, _cols);
-    _precision = 8;
-}
+#if defined(_WIN32)
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace plotter_detail {
+
+    /**
+     * @brief Runs tasks on a group of worker threads.
+     * 
+     * The workers claim task indices from a shared counter until all tasks are taken.
+     * The first exception thrown by a task is rethrown once all workers have finished.
+     * 
+     * @param task_count The number of tasks.
+     * @param threads The number of worker threads, zero selects the hardware concurrency.
+     * @param task The task, called with the index of the worker and the index of the task.
+     */
+    void run_parallel(std::size_t task_count, unsigned int threads, const std::function<void(std::size_t, std::size_t)>& task) {
+        std::size_t worker_count = threads != 0 ? threads : std::max(1u, std::thread::hardware_concurrency());
+        worker_count = std::max<std::size_t>(1, std::min(worker_count, task_count));
+
+        std::atomic<std::size_t> next_task{ 0 };
+        std::exception_ptr error;
+        std::mutex error_mutex;
+
+        auto work = [&](std::size_t worker) {
+            try {
+                for (std::size_t i = next_task.fetch_add(1); i < task_count; i = next_task.fetch_add(1)) {
+                    task(worker, i);
+                }
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if (!error) {
+                    error = std::current_exception();
+                }
+                next_task.store(task_count);
+            }
+        };
+
+        std::vector<std::thread> workers;
+        for (std::size_t worker = 1; worker < worker_count; worker++) {
+            workers.emplace_back(work, worker);
+        }
+        work(0);
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
 
-/**
- * @brief Prints the table with headers and content.
- * 
- * This function prints the table with headers and content. It first prints the table header,
- * followed by the columns header, and then the content. Finally, it outputs the table as a string.
- * 
- * @tparam T The type of data in the table.
- */
-template <typename T>
-void Plotter<T>::print_table() {
-    try {
-        print_table_header();
-        print_columns_header();
-        print_content();
+        if (error) {
+            std::rethrow_exception(error);
+        }
     }
-    catch (const std::exception& e) {
-        std::cout << "Error printing table: " << e.what();
+}
+
+namespace {
+
+    using plotter_detail::heatmap_levels;
+    using plotter_detail::heatmap_glyph;
+    using plotter_detail::HeatmapLut;
+
+    /**
+     * @brief Maps a heat level to a color on the blue-cyan-green-yellow-red ramp.
+     * 
+     * @param level The heat level in the range [0, heatmap_levels).
+     * @param r Red component output.
+     * @param g Green component output.
+     * @param b Blue component output.
+     */
+    void heatmap_ramp(std::size_t level, int& r, int& g, int& b) {
+        static const int stops[5][3] = { {0, 0, 255}, {0, 255, 255}, {0, 255, 0}, {255, 255, 0}, {255, 0, 0} };
+
+        double position = static_cast<double>(level) * 4.0 / (heatmap_levels - 1);
+        std::size_t stop = std::min<std::size_t>(static_cast<std::size_t>(position), 3);
+        double t = position - stop;
+
+        r = static_cast<int>(stops[stop][0] + (stops[stop + 1][0] - stops[stop][0]) * t + 0.5);
+        g = static_cast<int>(stops[stop][1] + (stops[stop + 1][1] - stops[stop][1]) * t + 0.5);
+        b = static_cast<int>(stops[stop][2] + (stops[stop + 1][2] - stops[stop][2]) * t + 0.5);
     }
-    catch (...) {
-        std::cout << "Error: An unknown error occurred while printing the table.";
+
+    /**
+     * @brief Builds the lookup table for one palette.
+     * 
+     * @param palette The terminal color mode.
+     * @return The lookup table for every heat level.
+     */
+    HeatmapLut build_heatmap_lut(HeatmapPalette palette) {
+        HeatmapLut lut;
+        for (std::size_t level = 0; level < heatmap_levels; level++) {
+            int r, g, b;
+            heatmap_ramp(level, r, g, b);
+
+            std::string& escape = lut.escapes[level];
+            if (palette == HeatmapPalette::TrueColor) {
+                escape = "\x1b[38;2;" + std::to_string(r) + ";" + std::to_string(g) + ";" + std::to_string(b) + "m";
+            }
+            else {
+                // nearest entry of the 6x6x6 color cube
+                int index = 16 + 36 * ((r * 5 + 127) / 255) + 6 * ((g * 5 + 127) / 255) + (b * 5 + 127) / 255;
+                escape = "\x1b[38;5;" + std::to_string(index) + "m";
+            }
+            escape += heatmap_glyph;
+
+            bool same_as_previous = level > 0 && escape == lut.escapes[level - 1];
+            lut.canonical_level[level] = same_as_previous ? lut.canonical_level[level - 1] : level;
+        }
+        return lut;
     }
-    _table << "\n";
-    std::cout << _table.str();
 }
 
-/**
- * @brief Get the table as a string.
- * 
- * This function generates a table by printing the table header, columns header, and content.
- * It returns the generated table as a string.
- * 
- * @tparam T The type of data in the table.
- * @return std::string The generated table as a string.
- */
-template <typename T>
-std::string Plotter<T>::get_table() {
-    try {
-        print_table_header();
-        print_columns_header();
-        print_content();
+namespace plotter_detail {
+
+    /**
+     * @brief Returns the lookup table for the palette, built once on first use.
+     * 
+     * @param palette The terminal color mode.
+     * @return The lookup table for every heat level.
+     */
+    const HeatmapLut& heatmap_lut(HeatmapPalette palette) {
+        static const HeatmapLut ansi256 = build_heatmap_lut(HeatmapPalette::Ansi256);
+        static const HeatmapLut truecolor = build_heatmap_lut(HeatmapPalette::TrueColor);
+        return palette == HeatmapPalette::TrueColor ? truecolor : ansi256;
     }
-    catch (const std::exception& e) {
-        std::cerr << "Error printing table: " + _name + "\n" << e.what() <<  "\n";
+
+    /**
+     * @brief Constructs a resource which forwards to upstream and counts into allocations.
+     * 
+     * @param upstream The resource the allocations are passed to.
+     * @param allocations The counter incremented by every allocation.
+     */
+    CountingResource::CountingResource(std::pmr::memory_resource* upstream, std::size_t& allocations)
+        : _upstream(upstream), _allocations(&allocations) {
     }
-    catch (...) {
-        std::cerr << "Error: An unknown error occurred while printing the table: " + _name + "\n";
+
+    void* CountingResource::do_allocate(std::size_t bytes, std::size_t alignment) {
+        (*_allocations)++;
+        return _upstream->allocate(bytes, alignment);
     }
 
-    _table << "\n";
-    return _table.str();
+    void CountingResource::do_deallocate(void* p, std::size_t bytes, std::size_t alignment) {
+        _upstream->deallocate(p, bytes, alignment);
+    }
+
+    bool CountingResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+        return this == &other;
+    }
+
+    /**
+     * @brief Finds the next line of a text wrapped to a width.
+     * 
+     * Lines break at the last whitespace which keeps them within the width, a word longer
+     * than the width is split. Whitespace around the break is not part of any line.
+     * 
+     * @param text The text being wrapped.
+     * @param position The position the line starts at, whitespace in front of it is skipped.
+     * @param width The maximum length of the line, it has to be positive.
+     * @param line Receives the line, a view into the text.
+     * @return The position of the next line, the length of the text after the last one.
+     */
+    std::size_t wrap_line(std::string_view text, std::size_t position, std::size_t width, std::string_view& line) {
+        auto is_space = [](char character) {
+            return character == ' ' || character == '\t' || character == '\n' || character == '\r';
+        };
+
+        while (position < text.length() && is_space(text[position])) {
+            position++;
+        }
+
+        std::size_t end = text.length();
+        std::size_t next = end;
+        if (end - position > width) {
+            // break at the last whitespace within reach, else split the word
+            end = position + width;
+            next = end;
+            for (std::size_t i = position + width; i > position; i--) {
+                if (is_space(text[i])) {
+                    end = i;
+                    next = i + 1;
+                    break;
+                }
+            }
+        }
+
+        while (end > position && is_space(text[end - 1])) {
+            end--;
+        }
+        while (next < text.length() && is_space(text[next])) {
+            next++;
+        }
+        line = text.substr(position, end - position);
+        return next;
+    }
+
+    /**
+     * @brief Replaces the decimal point and inserts thousands separators into a formatted number.
+     * 
+     * The integer digits are the run of digits after an optional sign, the text behind them
+     * is moved right to make room for the separators. Text without integer digits, like nan,
+     * and numbers which would no longer fit the buffer keep their digits as they are.
+     * 
+     * @param buffer The buffer which starts with the number.
+     * @param length The length of the number.
+     * @param format The characters of the number format.
+     * @return The length of the localized number.
+     */
+    std::size_t localize_number(std::span<char> buffer, std::size_t length, const NumberFormat& format) {
+        char* text = buffer.data();
+        std::size_t digits_begin = length != 0 && (text[0] == '-' || text[0] == '+') ? 1 : 0;
+        std::size_t digits_end = digits_begin;
+        while (digits_end < length && text[digits_end] >= '0' && text[digits_end] <= '9') {
+            digits_end++;
+        }
+
+        if (digits_end < length && text[digits_end] == '.') {
+            text[digits_end] = format.decimal_point;
+        }
+
+        std::size_t digits = digits_end - digits_begin;
+        std::size_t separators = format.thousands_separator != '\0' && digits != 0 ? (digits - 1) / 3 : 0;
+        if (separators == 0 || length + separators > buffer.size()) {
+            return length;
+        }
+
+        std::memmove(text + digits_end + separators, text + digits_end, length - digits_end);
+        char* source = text + digits_end;
+        char* target = text + digits_end + separators;
+        for (std::size_t i = 0; i < digits; i++) {
+            if (i != 0 && i % 3 == 0) {
+                *--target = format.thousands_separator;
+            }
+            *--target = *--source;
+        }
+        return length + separators;
+    }
 }
 
+#if !defined(_WIN32)
+
+namespace plotter_detail {
+
+    /**
+     * @brief Creates or truncates the file, resizes it and maps it for writing.
+     * 
+     * @param path The path of the file.
+     * @param size The size of the file in bytes.
+     * @throws std::system_error If the file cannot be created, resized or mapped.
+     */
+    MappedFile::MappedFile(const std::string& path, std::size_t size)
+        : _file(-1), _data(nullptr), _size(size) {
+        _file = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (_file < 0) {
+            throw std::system_error(errno, std::generic_category(), "Plotter: cannot open output file " + path);
+        }
+        if (::ftruncate(_file, static_cast<off_t>(size)) != 0) {
+            int error = errno;
+            ::close(_file);
+            throw std::system_error(error, std::generic_category(), "Plotter: cannot resize output file " + path);
+        }
+        void* mapping = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, _file, 0);
+        if (mapping == MAP_FAILED) {
+            int error = errno;
+            ::close(_file);
+            throw std::system_error(error, std::generic_category(), "Plotter: cannot map output file " + path);
+        }
+        _data = static_cast<char*>(mapping);
+    }
+
+    MappedFile::~MappedFile() {
+        ::munmap(_data, _size);
+        ::close(_file);
+    }
+}
+
+#endif
+
 /**
- * @brief Prints the table header.
+ * @brief Constructs a RenderArena.
  * 
- * This function calculates the left and right padding for the table header based on the table width and the length of the name.
- * It then prints the table header with the name centered.
+ * @param initial_size The size of the buffer allocated up front, in bytes.
+ * @param upstream The resource the buffer and any overflow blocks are allocated from.
+ */
+RenderArena::RenderArena(std::size_t initial_size, std::pmr::memory_resource* upstream)
+    : _upstream(upstream), _buffer(initial_size, upstream), _allocated(0) {
+    _resource.emplace(_buffer.data(), _buffer.size(), _upstream);
+}
+
+/**
+ * @brief Frees everything allocated since the last reset.
  * 
- * @tparam T The type of the Plotter.
+ * If more memory was requested than the buffer holds, the buffer grows to the
+ * requested amount, so the next render of the same size is served from the buffer alone.
  */
-template <typename T>
-void Plotter<T>::print_table_header() {
+void RenderArena::reset() {
+    _resource.reset();
+    if (_allocated > _buffer.size()) {
+        _buffer.resize(_allocated + _allocated / 2);
+    }
+    _allocated = 0;
+    _resource.emplace(_buffer.data(), _buffer.size(), _upstream);
+}
+
+void* RenderArena::do_allocate(std::size_t bytes, std::size_t alignment) {
+    _allocated += bytes + alignment;
+    return _resource->allocate(bytes, alignment);
+}
+
+void RenderArena::do_deallocate(void* p, std::size_t bytes, std::size_t alignment) {
+    _resource->deallocate(p, bytes, alignment);
+}
 
-    int left_padding = (_table_width - _name.length() - 2) / 2;
-    int right_padding = _table_width - _name.length() - 2 - left_padding;
+bool RenderArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
 
-    _table << "\n";
-    _table << "+" << std::string(_table_width - 2, '-') << "+" << "\n"
-        << "|" << std::string(left_padding, ' ') << _name << std::string(right_padding, ' ') << "|" << "\n"
-        << "+" << std::string(_table_width - 2, '-') << "+" << "\n";
+/**
+ * @brief Constructs an empty recorder, event times are relative to its construction.
+ */
+RenderTrace::RenderTrace()
+    : _origin(std::chrono::steady_clock::now()) {
 }
 
 /**
- * @brief Prints the header of the columns in the table.
+ * @brief Adds a complete event which started at start and ends now.
  * 
- * This function prints the header of the columns in the table. It iterates over the column names,
- * calculates the padding for each column, and prints the header with the appropriate padding.
+ * Threads are numbered in the order of their first event.
  * 
- * @tparam T The type of data stored in the table.
+ * @param name The name of the event, it has to outlive the recorder.
+ * @param start The time the event started.
+ * @param first The first row or table the event covers, no_range for none.
+ * @param count The number of rows or tables the event covers.
  */
-template <typename T>
-void Plotter<T>::print_columns_header() {
-    _table << "|";
-    for (unsigned int i = 0; i < _cols; i++) {
-        std::string header = _column_names[i];
-        int left_padding = (_column_width - header.length()) / 2;
-        int right_padding = _column_width - header.length() - left_padding;
-        _table << std::string(left_padding, ' ') << header << std::string(right_padding, ' ') << "|";
+void RenderTrace::record(const char* name, std::chrono::steady_clock::time_point start, std::size_t first, std::size_t count) {
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    std::thread::id id = std::this_thread::get_id();
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    std::size_t thread = static_cast<std::size_t>(std::find(_threads.begin(), _threads.end(), id) - _threads.begin());
+    if (thread == _threads.size()) {
+        _threads.push_back(id);
     }
-    _table << "\n";
-    print_endline();
+    _events.push_back(Event{ name, start, end - start, thread, first, count });
 }
 
 /**
- * @brief Prints the content of the Plotter object.
+ * @brief Writes the events as a Chrome trace JSON document.
  * 
- * This function prints the content of the Plotter object based on the data arrangement.
- * If the data arrangement is set to RowMajor, it prints each row of the data array.
- * If the data arrangement is set to ColumnMajor, it prints each column of the data array.
+ * Every event is a complete event with the timestamp and duration in microseconds,
+ * events covering rows or tables carry them as arguments. Numbers are formatted by
+ * std::to_chars, so the document does not depend on the locale of the stream.
+ * 
+ * @param out The stream the document is written to.
  */
-template <typename T>
-void Plotter<T>::print_content() {
-    if (_data_arrangement == DataArrangement::RowMajor) {
-        for (unsigned int i = 0; i < _rows; i++) {
-            print_row(i * _cols, _cols, 1);
-        }
-    }
-    else {
-        for (unsigned int i = 0; i < _rows; i++) {
-            print_row(i, _cols, _rows);
+void RenderTrace::write_json(std::ostream& out) const {
+    std::string json;
+    std::array<char, 32> buffer;
+    auto append_number = [&](auto value) {
+        json.append(buffer.data(), std::to_chars(buffer.data(), buffer.data() + buffer.size(), value).ptr);
+    };
+    auto append_microseconds = [&](std::chrono::steady_clock::duration duration) {
+        double value = std::chrono::duration<double, std::micro>(duration).count();
+        json.append(buffer.data(), std::to_chars(buffer.data(), buffer.data() + buffer.size(), value, std::chars_format::fixed, 3).ptr);
+    };
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    json += "{\"traceEvents\":[";
+    for (std::size_t i = 0; i < _events.size(); i++) {
+        const Event& event = _events[i];
+        json += i == 0 ? "\n" : ",\n";
+        json += "{\"name\":\"";
+        json += event.name;
+        json += "\",\"cat\":\"plotter\",\"ph\":\"X\",\"pid\":1,\"tid\":";
+        append_number(event.thread);
+        json += ",\"ts\":";
+        append_microseconds(event.start - _origin);
+        json += ",\"dur\":";
+        append_microseconds(event.duration);
+        if (event.first != no_range) {
+            json += ",\"args\":{\"first\":";
+            append_number(event.first);
+            json += ",\"count\":";
+            append_number(event.count);
+            json += "}";
         }
+        json += "}";
     }
-    print_endline();
+    json += "\n],\"displayTimeUnit\":\"ns\"}\n";
+    out.write(json.data(), static_cast<std::streamsize>(json.size()));
 }
 
 /**
- * @brief Prints a row of data in a table format.
- * 
- * This function prints a row of data in a table format, where each cell represents a value from the data array.
- * If a value is longer than the specified column width, it is stored in a buffer and printed at the end of the row.
- * 
- * @tparam T The type of data stored in the array.
- * @param start_index The starting index of the row in the data array.
- * @param cell_count The number of cells to print in the row.
- * @param stride The stride between consecutive cells in the data array.
+ * @brief Returns the number of recorded events.
  */
-template <typename T>
-void Plotter<T>::print_row(unsigned int start_index, unsigned int cell_count, int stride) {
-
-    // buffer for values which are longer than the column width
-    // they will be stored and printed at the end of the row
-    std::stringstream too_long_values_buffer;
-
-    _table << "|";
-    for (unsigned int j = 0; j < cell_count; j++) {
-
-        auto value = _data[start_index + j * stride];
+std::size_t RenderTrace::size() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _events.size();
+}
 
-        if (!col_width_is_sufficient(value, _column_width)) {
-            too_long_values_buffer << "\n\n" << "cell: " << j << " value: " << value;
+/**
+ * @brief Removes all events, the thread numbering and time origin are kept.
+ */
+void RenderTrace::clear() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _events.clear();
+}
 
-            // initialize to default T value
-            value = T();
-        }
+/**
+ * @brief Adds the metrics of other renders.
+ * 
+ * @param other The metrics to add.
+ * @return This object.
+ */
+RenderStats& RenderStats::operator+=(const RenderStats& other) {
+    cells_formatted += other.cells_formatted;
+    overflow_cells += other.overflow_cells;
+    bytes_emitted += other.bytes_emitted;
+    allocations += other.allocations;
+    format_time += other.format_time;
+    overflow_time += other.overflow_time;
+    frame_time += other.frame_time;
+    sink_time += other.sink_time;
+    cache_lookups += other.cache_lookups;
+    cache_hits += other.cache_hits;
+    return *this;
+}
 
-        _table << std::setw(_column_width) << std::setprecision(_precision) << std::fixed << value << "|";
-    }
-    // too long values are printed without formatting because of complexity
-    _table << too_long_values_buffer.str();
-    _table << "\n";
+/**
+ * @brief Constructs an empty fixed writer.
+ */
+TableWriter::TableWriter()
+    : _string(nullptr), _begin(nullptr), _cursor(nullptr), _end(nullptr), _allocations(0) {
 }
 
 /**
- * @brief Checks if the column width is sufficient to display the given value.
+ * @brief Constructs a growable writer which appends to the end of the string.
  * 
- * This function converts the value to a string with a fixed precision of _precision decimal places
- * and checks if the length of the resulting string is less than or equal to the specified column width.
+ * @param string The string the output is appended to, finish() trims it to the written size.
+ */
+TableWriter::TableWriter(std::string& string)
+    : _string(&string), _begin(string.data() + string.size()), _cursor(_begin), _end(_begin), _allocations(0) {
+}
+
+/**
+ * @brief Constructs a fixed writer over a caller-provided buffer.
  * 
- * @tparam T The type of the value.
- * @param value The value to be checked.
- * @param column_width The width of the column.
- * @return True if the column width is sufficient, false otherwise.
+ * @param buffer The buffer the output is written to.
  */
-template <typename T>
-bool Plotter<T>::col_width_is_sufficient(T value, unsigned int column_width) {
-    std::stringstream ss;
-    ss << std::setprecision(_precision) << std::fixed << value;
-    return ss.str().length() <= column_width;
-};
+TableWriter::TableWriter(std::span<char> buffer)
+    : _string(nullptr), _begin(buffer.data()), _cursor(buffer.data()), _end(buffer.data() + buffer.size()), _allocations(0) {
+}
 
 /**
- * @brief Validates the inputs of the Plotter class and throws an exception if they are invalid.
+ * @brief Makes room for count more bytes.
  * 
- * This function checks if the data pointer is null and if the column names vector is empty.
- * If either of these conditions is true, it prints an error message to the standard error stream
- * and throws an std::invalid_argument exception with an appropriate error message.
+ * The string grows by at least the amount this writer has written so far, so the
+ * bytes initialized by resizing stay proportional to the output of the writer,
+ * even when it appends to a long string.
  * 
- * @tparam T The type of data stored in the Plotter.
- * @throws std::invalid_argument If the data pointer is null or the column names vector is empty.
+ * @param count The number of bytes which have to fit behind the cursor.
+ * @throws std::length_error If the writer has a fixed buffer.
  */
-template <typename T>
-void Plotter<T>::validate_inputs_throw_exception() {
-    if (_data == nullptr) {
-        throw std::invalid_argument("Plotter: data pointer cannot be null.");
+void TableWriter::grow(std::size_t count) {
+    if (_string == nullptr) {
+        throw std::length_error("Plotter: output buffer is too small for the table.");
     }
 
-    if (_column_names.empty()) {
-        throw std::invalid_argument("Plotter: column names vector cannot be empty.");
+    std::size_t offset = static_cast<std::size_t>(_begin - _string->data());
+    std::size_t used = static_cast<std::size_t>(_cursor - _string->data());
+    std::size_t capacity = _string->capacity();
+    _string->resize(used + std::max({ count, used - offset, std::size_t(256) }));
+    if (_string->capacity() != capacity) {
+        _allocations++;
     }
 
-    if (_table_width == 0) {
-        throw std::invalid_argument("Plotter: table width cannot be zero.");
-    }
-
-    if (_size == 0) {
-        throw std::invalid_argument("Plotter: size cannot be zero.");
-    }
+    _begin = _string->data() + offset;
+    _cursor = _string->data() + used;
+    _end = _string->data() + _string->size();
 }
 
 /**
- * @brief Calculates the column width for a table.
+ * @brief Ends the output, a growable string is trimmed to the written size.
  * 
- * This function calculates the width of each column in a table based on the total table width and the number of columns.
- * 
- * @param table_width The total width of the table.
- * @param cols The number of columns in the table.
- * @return The calculated column width.
+ * @return The number of bytes written by this writer.
  */
-template <typename T>
-int Plotter<T>::calculate_column_width(int table_width, int cols) {
-    return (table_width - (cols + 1)) / cols;
+std::size_t TableWriter::finish() {
+    if (_string != nullptr) {
+        _string->resize(static_cast<std::size_t>(_cursor - _string->data()));
+    }
+    return size();
 }
 
 /**
- * @brief Calculates the number of rows needed to display a given number of elements in a specified number of columns.
+ * @brief Returns the width of the terminal the standard output is attached to.
  * 
- * @tparam T The type of the elements.
- * @param size The total number of elements.
- * @param column_count The number of columns.
- * @return The number of rows needed to display the elements.
- */
-template <typename T>
-int Plotter<T>::calculate_rows(int size, int column_count) {
-    return size / column_count;
-}
-
-/**
- * @brief Prints a horizontal line with '+' at the beginning and end.
+ * The width is queried from the terminal (TIOCGWINSZ, or the console screen buffer on Windows).
+ * When the output is not a terminal, the COLUMNS environment variable is used, then the fallback.
  * 
- * This method is used to print a horizontal line in the table with '+' at the beginning and end.
- * The length of the line is determined by the `_table_width` member variable.
+ * @param fallback The width used when no width is known.
+ * @return The width of the terminal in characters.
  */
-template <typename T>
-void Plotter<T>::print_endline() {
-    _table << "+";
-    _table << std::string(_table_width - 2, '-');
-    _table << "+";
-    _table << "\n";
+std::size_t terminal_width(std::size_t fallback) {
+#if defined(_WIN32)
+    CONSOLE_SCREEN_BUFFER_INFO info;
+    if (GetConsoleScreenBufferInfo(GetStdHandle(STD_OUTPUT_HANDLE), &info)) {
+        return static_cast<std::size_t>(info.srWindow.Right - info.srWindow.Left + 1);
+    }
+#else
+    winsize size{};
+    if (::ioctl(STDOUT_FILENO, TIOCGWINSZ, &size) == 0 && size.ws_col != 0) {
+        return size.ws_col;
+    }
+#endif
+
+    if (const char* columns = std::getenv("COLUMNS")) {
+        std::size_t width = 0;
+        const char* end = columns + std::strlen(columns);
+        if (std::from_chars(columns, end, width).ptr == end && width != 0) {
+            return width;
+        }
+    }
+    return fallback;
 }
 
-// Explicit instantiation
+// Explicit instantiation of the common types, declared extern in Plotter.hpp
 template class Plotter<int>;
+template class Plotter<long>;
+template class Plotter<long long>;
+template class Plotter<unsigned int>;
+template class Plotter<unsigned long>;
+template class Plotter<unsigned long long>;
 template class Plotter<double>;
 template class Plotter<float>;
+template class Plotter<long double>;
 template class Plotter<std::string>;
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
+template class Plotter<std::string_view>;
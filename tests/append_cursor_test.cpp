@@ -0,0 +1,90 @@
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "Plotter.hpp"
+
+// A table emitted piece by piece while its buffer grows, with get_new_rows after every set_data
+// and finalize for the partial last row, has to equal get_table of the whole buffer, also with
+// hidden columns. ColumnMajor tables, paged renders and finalized cursors are reported on
+// std::cerr, return nothing and leave the cursor as it was.
+
+namespace {
+
+    int failures = 0;
+
+    void check(bool condition, const std::string& message) {
+        if (!condition) {
+            std::cerr << message << "\n";
+            failures++;
+        }
+    }
+
+    /**
+     * @brief Runs the render with std::cerr captured and checks that it reported the error and changed nothing.
+     */
+    template <typename Render>
+    void check_rejected(const std::string& name, AppendCursor& cursor, const std::string& reason, Render&& render) {
+        AppendCursor before = cursor;
+        std::ostringstream errors;
+        std::streambuf* previous = std::cerr.rdbuf(errors.rdbuf());
+        std::string output = render();
+        std::cerr.rdbuf(previous);
+
+        check(output.empty(), name + ": returned output");
+        check(errors.str().find("Error printing table: cursor") != std::string::npos && errors.str().find(reason) != std::string::npos,
+            name + ": reported \"" + errors.str() + "\"");
+        check(cursor.emitted_rows == before.emitted_rows && cursor.header_emitted == before.header_emitted && cursor.finalized == before.finalized,
+            name + ": changed the cursor");
+    }
+}
+
+int main() {
+    std::vector<std::string> column_names = { "a", "b", "c", "d", "e", "f" };
+    std::vector<unsigned int> priorities = { 3, 1, 2, 3, 1, 3 };
+
+    // the buffer grows by steps which end inside rows, the last row stays partial
+    std::vector<int> buffer = { 7 };
+    Plotter<int> growing(buffer.data(), "cursor", column_names, 40, buffer.size(), DataArrangement::RowMajor);
+    growing.set_column_priorities(priorities, 8);
+    AppendCursor cursor;
+    std::string emitted;
+    for (std::size_t size : { 1, 4, 6, 13, 13, 30, 44 }) {
+        while (buffer.size() < size) {
+            buffer.push_back(static_cast<int>(buffer.size() * 37 % 1000) - 500);
+        }
+        growing.set_data(buffer.data(), buffer.size());
+        emitted += growing.get_new_rows(cursor);
+        check(cursor.emitted_rows == size / column_names.size(), "after " + std::to_string(size) + " values: " + std::to_string(cursor.emitted_rows) + " rows emitted");
+    }
+    emitted += growing.finalize(cursor);
+    check(cursor.finalized, "finalize did not finalize the cursor");
+
+    Plotter<int> whole(buffer.data(), "cursor", column_names, 40, buffer.size(), DataArrangement::RowMajor);
+    whole.set_column_priorities(priorities, 8);
+    std::string table = whole.get_table();
+    check(emitted == table, "the emitted pieces differ from get_table\n" + emitted + "\nexpected\n" + table);
+    // only the header has letters, the columns b and e have the lowest priority
+    check(table.find('b') == std::string::npos && table.find('e') == std::string::npos && table.find('f') != std::string::npos,
+        "the low priority columns are not hidden\n" + table);
+
+    // a finalized cursor takes no more rows
+    check_rejected("finalized get_new_rows", cursor, "already finalized", [&] { return growing.get_new_rows(cursor); });
+    check_rejected("finalized finalize", cursor, "already finalized", [&] { return growing.finalize(cursor); });
+
+    // other arrangements and pages change rows which are already emitted
+    Plotter<int> column_major(buffer.data(), "cursor", column_names, 40, buffer.size(), DataArrangement::ColumnMajor);
+    AppendCursor column_cursor;
+    check_rejected("ColumnMajor get_new_rows", column_cursor, "RowMajor", [&] { return column_major.get_new_rows(column_cursor); });
+    check_rejected("ColumnMajor finalize", column_cursor, "RowMajor", [&] { return column_major.finalize(column_cursor); });
+
+    AppendCursor paged_cursor;
+    paged_cursor.emitted_rows = 2;
+    paged_cursor.header_emitted = true;
+    check_rejected("paged get_new_rows", paged_cursor, "paged", [&] { return whole.get_new_rows(paged_cursor, { .paged_column_width = 10 }); });
+    check_rejected("paged finalize", paged_cursor, "paged", [&] { return whole.finalize(paged_cursor, { .paged_column_width = 10 }); });
+
+    std::cout << failures << " failures\n";
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
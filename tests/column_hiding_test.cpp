@@ -0,0 +1,126 @@
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "Plotter.hpp"
+
+// Tables whose width is taken from the terminal hide the columns which do not fit, also without
+// priorities, and tables with a minimum column width hide columns until their names fit.
+// The terminal width is set by COLUMNS, the test is skipped when the output is a terminal.
+
+namespace {
+
+    constexpr int skipped = 77;
+
+    int failures = 0;
+
+    void check(bool condition, const std::string& message) {
+        if (!condition) {
+            std::cerr << message << "\n";
+            failures++;
+        }
+    }
+
+    std::vector<std::string> names(const std::string& prefix, std::size_t count) {
+        std::vector<std::string> column_names;
+        for (std::size_t j = 0; j < count; j++) {
+            column_names.push_back(prefix + std::to_string(j));
+        }
+        return column_names;
+    }
+
+    /**
+     * @brief Returns the names in the columns header, the second line between bars.
+     */
+    std::vector<std::string> header_names(const std::string& table) {
+        int bar_lines = 0;
+        for (std::size_t begin = 0, end; (end = table.find('\n', begin)) != std::string::npos; begin = end + 1) {
+            if (table[begin] != '|' || ++bar_lines != 2) {
+                continue;
+            }
+            std::vector<std::string> header;
+            for (std::size_t cell = begin + 1, next; (next = table.find('|', cell)) < end; cell = next + 1) {
+                std::string name = table.substr(cell, next - cell);
+                std::size_t first = name.find_first_not_of(' ');
+                header.push_back(first == std::string::npos ? "" : name.substr(first, name.find_last_not_of(' ') - first + 1));
+            }
+            return header;
+        }
+        return {};
+    }
+
+    /**
+     * @brief Checks that the layout is valid, the table shows exactly the expected columns and fits the width.
+     */
+    template <typename T>
+    void check_table(const std::string& name, const Plotter<T>& plotter, std::size_t width, const std::vector<std::string>& shown) {
+        std::size_t size = 0;
+        try {
+            size = plotter.rendered_size();
+        }
+        catch (const std::length_error& e) {
+            check(false, name + ": invalid layout, " + e.what());
+            return;
+        }
+        std::string table = plotter.get_table();
+        check(size == table.size(), name + ": rendered_size differs from the output size");
+
+        std::vector<std::string> header = header_names(table);
+        std::string header_text;
+        for (const std::string& column : header) {
+            header_text += column + " ";
+        }
+        check(header == shown, name + ": shows the columns " + header_text);
+
+        for (std::size_t begin = 0, end; (end = table.find('\n', begin)) != std::string::npos; begin = end + 1) {
+            check(end - begin <= width, name + ": a line is wider than " + std::to_string(width));
+        }
+    }
+}
+
+int main() {
+#if defined(_WIN32)
+    _putenv_s("COLUMNS", "50");
+#else
+    setenv("COLUMNS", "50", 1);
+#endif
+    if (terminal_width(0) != 50) {
+        std::cout << "skipped, the output is a terminal\n";
+        return skipped;
+    }
+
+    // twelve columns of doubles in 50 characters, a cell of 0.00000000 needs 10 characters
+    std::vector<double> doubles(36, 1.5);
+    Plotter<double> auto_doubles(doubles.data(), "auto", names("col", 12), 0, doubles.size(), DataArrangement::RowMajor);
+    check_table("auto width", auto_doubles, 50, { "col0", "col1", "col2", "col3" });
+
+    // more decimal places make the default cell wider and hide one more column
+    auto_doubles.set_precision(10);
+    check_table("auto width, precision 10", auto_doubles, 50, { "col0", "col1", "col2" });
+
+    // the names are wider than the numbers
+    std::vector<int> ints(18, 7);
+    std::vector<std::string> long_names = names("a_long_column_name_", 6);
+    Plotter<int> auto_ints(ints.data(), "names", long_names, 0, ints.size(), DataArrangement::ColumnMajor);
+    check_table("auto width, long names", auto_ints, 50, { "a_long_column_name_0", "a_long_column_name_1" });
+
+    // priorities keep the wide column, the narrow ones are hidden until its name fits
+    Plotter<int> prioritized(ints.data(), "mixed", { "a", "b", "c", "a_very_wide_column", "d", "e" }, 60, ints.size(), DataArrangement::RowMajor);
+    prioritized.set_column_priorities({ 1, 1, 1, 5, 1, 1 }, 3);
+    check_table("priorities and names", prioritized, 60, { "a", "b", "a_very_wide_column" });
+
+    // a fixed width without a minimum hides nothing, the names which do not fit are an error
+    Plotter<int> fixed(ints.data(), "fixed", long_names, 50, ints.size(), DataArrangement::RowMajor);
+    bool rejected = false;
+    try {
+        fixed.rendered_size();
+    }
+    catch (const std::length_error&) {
+        rejected = true;
+    }
+    check(rejected, "fixed width: columns were hidden without a minimum width");
+
+    std::cout << failures << " failures\n";
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
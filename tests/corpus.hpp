@@ -0,0 +1,171 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include "Plotter.hpp"
+
+// Fixed corpus of tables shared by the golden output and throughput tests.
+// The values are generated by a portable generator and chosen to be exactly representable,
+// so the rendered text is the same on every platform.
+
+namespace plotter_tests {
+
+    /**
+     * @brief Linear congruential generator, the sequence does not depend on the standard library.
+     */
+    class Lcg {
+
+        std::uint64_t _state;
+
+    public:
+
+        explicit Lcg(std::uint64_t seed) : _state(seed) {}
+
+        std::uint64_t next() {
+            _state = _state * 6364136223846793005ull + 1442695040888963407ull;
+            return _state >> 11 | _state << 53;
+        }
+
+        std::uint64_t below(std::uint64_t bound) {
+            return next() % bound;
+        }
+    };
+
+    /**
+     * @brief Kind of corpus data, Free fits every cell, Heavy overflows most cells.
+     */
+    enum class Overflow {
+        Free,
+        Heavy
+    };
+
+    constexpr std::size_t corpus_columns = 5;
+
+    /**
+     * @brief Returns a random value of the corpus.
+     *
+     * Free values fit the 14 characters of the wide table, heavy values mostly exceed
+     * the 6 characters of the narrow one. long and unsigned long stay in 32 bits,
+     * as their width differs between platforms.
+     */
+    template <typename T>
+    T make_value(Lcg& rng, Overflow overflow) {
+        bool heavy = overflow == Overflow::Heavy;
+        if constexpr (std::is_floating_point_v<T>) {
+            // multiples of 1/64 below 8192 and integers below 2^60 are exact in every floating point type
+            // the draws are separate statements, the order of operands is unspecified
+            double magnitude = static_cast<double>(rng.below(heavy ? 1u << 20 : 1u << 19));
+            magnitude = heavy ? magnitude * static_cast<double>(1ull << rng.below(41)) : magnitude / 64.0;
+            return static_cast<T>(rng.below(3) == 0 ? -magnitude : magnitude);
+        }
+        else if constexpr (std::is_integral_v<T>) {
+            if (!heavy) {
+                T value = static_cast<T>(rng.below(100000));
+                if constexpr (std::is_signed_v<T>) {
+                    return rng.below(3) == 0 ? static_cast<T>(-value) : value;
+                }
+                return value;
+            }
+            if constexpr (sizeof(T) > 4 && (std::is_same_v<T, long> || std::is_same_v<T, unsigned long>)) {
+                using Narrow = std::conditional_t<std::is_signed_v<T>, std::int32_t, std::uint32_t>;
+                return static_cast<T>(static_cast<Narrow>(rng.next()));
+            }
+            return static_cast<T>(rng.next());
+        }
+        else {
+            std::size_t length = heavy ? 5 + rng.below(26) : 1 + rng.below(6);
+            std::string text;
+            for (std::size_t i = 0; i < length; i++) {
+                text += heavy && i != 0 && rng.below(5) == 0 ? ' ' : static_cast<char>('a' + rng.below(26));
+            }
+            return T(text);
+        }
+    }
+
+    /**
+     * @brief One table of the corpus, its data stays in place while the table lives.
+     */
+    template <typename T>
+    struct CorpusTable {
+        std::string name;
+        std::vector<std::string> texts;
+        std::vector<T> data;
+        std::vector<std::string> column_names;
+        std::size_t table_width;
+        DataArrangement arrangement;
+
+        CorpusTable(std::string type_name, DataArrangement data_arrangement, Overflow overflow, std::size_t rows)
+            : name(std::move(type_name)), table_width(overflow == Overflow::Free ? 80 : 40), arrangement(data_arrangement) {
+            name += arrangement == DataArrangement::RowMajor ? "_row" : "_col";
+            name += overflow == Overflow::Free ? "_free" : "_heavy";
+
+            // the last row is partial
+            std::size_t size = rows * corpus_columns - 2;
+            // FNV-1a of the name seeds the generator, so every table has its own data
+            std::uint64_t seed = 14695981039346656037ull;
+            for (char c : name) {
+                seed = (seed ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+            }
+            Lcg rng(seed);
+            if constexpr (std::is_same_v<T, std::string_view>) {
+                // the views refer to strings which do not move any more
+                texts.reserve(size);
+                for (std::size_t i = 0; i < size; i++) {
+                    texts.push_back(make_value<std::string>(rng, overflow));
+                }
+                data.assign(texts.begin(), texts.end());
+            }
+            else {
+                for (std::size_t i = 0; i < size; i++) {
+                    data.push_back(make_value<T>(rng, overflow));
+                }
+            }
+            for (std::size_t j = 0; j < corpus_columns; j++) {
+                column_names.push_back("c" + std::to_string(j));
+            }
+        }
+
+        CorpusTable(const CorpusTable&) = delete;
+        CorpusTable& operator=(const CorpusTable&) = delete;
+
+        Plotter<T> plotter() {
+            return Plotter<T>(data.data(), "corpus " + name, column_names, table_width, data.size(), arrangement);
+        }
+    };
+
+    /**
+     * @brief Calls visit.template operator()<T>(name) for every type instantiated in Plotter.cpp.
+     */
+    template <typename Visitor>
+    void for_each_type(Visitor&& visit) {
+        visit.template operator()<int>("int");
+        visit.template operator()<long>("long");
+        visit.template operator()<long long>("long_long");
+        visit.template operator()<unsigned int>("unsigned_int");
+        visit.template operator()<unsigned long>("unsigned_long");
+        visit.template operator()<unsigned long long>("unsigned_long_long");
+        visit.template operator()<double>("double");
+        visit.template operator()<float>("float");
+        visit.template operator()<long double>("long_double");
+        visit.template operator()<std::string>("string");
+        visit.template operator()<std::string_view>("string_view");
+    }
+
+    /**
+     * @brief Calls visit(table) for every table of the corpus, each type in both arrangements
+     * with overflow free and overflow heavy data.
+     */
+    template <typename Visitor>
+    void for_each_table(std::size_t rows, Visitor&& visit) {
+        for_each_type([&]<typename T>(const char* type_name) {
+            for (DataArrangement arrangement : { DataArrangement::RowMajor, DataArrangement::ColumnMajor }) {
+                for (Overflow overflow : { Overflow::Free, Overflow::Heavy }) {
+                    CorpusTable<T> table(type_name, arrangement, overflow, rows);
+                    visit(table);
+                }
+            }
+        });
+    }
+}
@@ -0,0 +1,88 @@
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "corpus.hpp"
+
+// A dictionary-encoded table has to render to the same bytes as the table with every code
+// replaced by its entry, in both arrangements, paged, with wrapped cells and with entries
+// too long for their column. rendered_size has to give the exact size and the constructor
+// has to reject codes outside the dictionary.
+
+namespace {
+
+    constexpr std::size_t dictionary_columns = 5;
+    constexpr std::size_t dictionary_size = 83;
+
+    int failures = 0;
+
+    void check(bool condition, const std::string& message) {
+        if (!condition) {
+            std::cerr << message << "\n";
+            failures++;
+        }
+    }
+
+    /**
+     * @brief Renders the coded and the expanded table with the options and compares them.
+     */
+    template <typename T>
+    void check_render(const std::string& name, const Plotter<T>& coded, const Plotter<T>& expanded, const RenderOptions& options) {
+        std::string table = coded.get_table(options);
+        check(table == expanded.get_table(options), name + ": the coded table differs from the expanded one");
+        check(coded.rendered_size(options) == table.size(), name + ": rendered_size differs from the output size");
+
+        RenderOptions stream = options;
+        stream.engine = CellEngine::Stream;
+        check(coded.get_table(stream) == table, name + ": the Stream engine differs from ToChars");
+    }
+
+    template <typename T>
+    void check_type(const std::string& type_name) {
+        // short entries, an empty one, one which wraps and ones too long for any column
+        std::vector<T> dictionary = { T("red"), T("green"), T(""), T("two words here"), T("a_long_entry_for_its_column"),
+            T("an entry which is too long for any column of the table at all") };
+
+        plotter_tests::Lcg source(5);
+        std::vector<std::uint32_t> codes;
+        std::vector<T> values;
+        for (std::size_t i = 0; i < dictionary_size; i++) {
+            codes.push_back(static_cast<std::uint32_t>(source.below(dictionary.size())));
+            values.push_back(dictionary[codes.back()]);
+        }
+        std::vector<std::string> column_names = { "c0", "c1", "c2", "c3", "c4" };
+
+        for (DataArrangement arrangement : { DataArrangement::RowMajor, DataArrangement::ColumnMajor }) {
+            Plotter<T> coded(codes.data(), dictionary, "dictionary", column_names, 60, codes.size(), arrangement);
+            Plotter<T> expanded(values.data(), "dictionary", column_names, 60, values.size(), arrangement);
+            std::string name = type_name + (arrangement == DataArrangement::RowMajor ? " RowMajor" : " ColumnMajor");
+
+            check_render(name, coded, expanded, {});
+            check_render(name + " paged", coded, expanded, { .paged_column_width = 15 });
+            check_render(name + " wrapped", coded, expanded, { .wrap_cells = true });
+            check_render(name + " paged and wrapped", coded, expanded, { .paged_column_width = 15, .wrap_cells = true });
+            check_render(name + " window", coded, expanded, { .first_row = 3, .row_count = 7 });
+        }
+
+        bool rejected = false;
+        codes.back() = static_cast<std::uint32_t>(dictionary.size());
+        try {
+            Plotter<T> invalid(codes.data(), dictionary, "dictionary", column_names, 60, codes.size(), DataArrangement::RowMajor);
+        }
+        catch (const std::invalid_argument&) {
+            rejected = true;
+        }
+        check(rejected, type_name + ": a code outside the dictionary was accepted");
+    }
+}
+
+int main() {
+    check_type<std::string>("string");
+    check_type<std::string_view>("string_view");
+
+    std::cout << failures << " failures\n";
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,112 @@
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "Plotter.hpp"
+
+// Diffs compared with fixed output: the changed cells are marked on the separator left of them,
+// also in rows whose cells are widened by a default value wider than the column,
+// ChangedRows keeps only the changed rows and an epsilon hides small changes.
+// The table itself keeps showing its own data.
+
+namespace {
+
+    int failures = 0;
+
+    void check(bool condition, const std::string& message) {
+        if (!condition) {
+            std::cerr << message << "\n";
+            failures++;
+        }
+    }
+
+    // the default cell 0.00000000 is wider than the columns, the cells are appended one by one
+    const std::string widened =
+        "\n"
+        "+-----------------------+\n"
+        "|         diff          |\n"
+        "+-----------------------+\n"
+        "|   a   |   b   |   c   |\n"
+        "+-----------------------+\n"
+        "|0.00000000*0.00000000|0.00000000|\n"
+        "\n"
+        "cell: 0 value: 1\n"
+        "\n"
+        "cell: 1 value: 2.5\n"
+        "\n"
+        "cell: 2 value: 3\n"
+        "|0.00000000|0.00000000*0.00000000|\n"
+        "\n"
+        "cell: 0 value: 4\n"
+        "\n"
+        "cell: 1 value: 5\n"
+        "\n"
+        "cell: 2 value: 7\n"
+        "+-----------------------+\n"
+        "\n";
+
+    const std::string changed_rows =
+        "\n"
+        "+-----------------------+\n"
+        "|         diff          |\n"
+        "+-----------------------+\n"
+        "|   a   |   b   |   c   |\n"
+        "+-----------------------+\n"
+        "row: 1\n"
+        "|      4*     50|      6|\n"
+        "row: 3\n"
+        "|     10|     11*    -12|\n"
+        "+-----------------------+\n"
+        "\n";
+
+    const std::string epsilon_table =
+        "\n"
+        "+--------------------------------------+\n"
+        "|                 eps                  |\n"
+        "+--------------------------------------+\n"
+        "|        a         |        b         |\n"
+        "+--------------------------------------+\n"
+        "|        1.00000000|        3.00000000|\n"
+        "|        2.05000000|        4.00000000|\n"
+        "+--------------------------------------+\n"
+        "\n";
+
+    const std::string epsilon_diff =
+        "\n"
+        "+--------------------------------------+\n"
+        "|                 eps                  |\n"
+        "+--------------------------------------+\n"
+        "|        a         |        b         |\n"
+        "+--------------------------------------+\n"
+        "|        1.00000000|        3.00000000|\n"
+        "*        2.05000000|        4.00000000|\n"
+        "+--------------------------------------+\n"
+        "\n";
+}
+
+int main() {
+    std::vector<double> before = { 1, 2, 3, 4, 5, 6 };
+    std::vector<double> after = { 1, 2.5, 3, 4, 5, 7 };
+    Plotter<double> narrow(before.data(), "diff", { "a", "b", "c" }, 25, before.size(), DataArrangement::RowMajor);
+    std::string table = narrow.get_table();
+    std::string diff = narrow.get_diff(after.data(), { DiffMode::AllRows });
+    check(diff == widened, "widened cells: the diff differs from the expected output\n" + diff);
+    check(narrow.get_table() == table, "widened cells: the diff changed the table");
+
+    std::vector<int> old_ints = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 };
+    std::vector<int> new_ints = { 1, 2, 3, 4, 50, 6, 7, 8, 9, 10, 11, -12 };
+    Plotter<int> ints(old_ints.data(), "diff", { "a", "b", "c" }, 25, old_ints.size(), DataArrangement::RowMajor);
+    diff = ints.get_diff(new_ints.data(), { DiffMode::ChangedRows });
+    check(diff == changed_rows, "changed rows: the diff differs from the expected output\n" + diff);
+
+    std::vector<double> old_doubles = { 1, 2, 3, 4 };
+    std::vector<double> new_doubles = { 1, 2.05, 3, 4 };
+    Plotter<double> doubles(old_doubles.data(), "eps", { "a", "b" }, 40, old_doubles.size(), DataArrangement::ColumnMajor);
+    diff = doubles.get_diff(new_doubles.data(), { DiffMode::AllRows, 0.1 });
+    check(diff == epsilon_table, "epsilon: a change within epsilon was marked\n" + diff);
+    diff = doubles.get_diff(new_doubles.data(), { DiffMode::AllRows });
+    check(diff == epsilon_diff, "epsilon: the diff differs from the expected output\n" + diff);
+
+    std::cout << failures << " failures\n";
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
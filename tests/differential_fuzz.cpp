@@ -0,0 +1,258 @@
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "corpus.hpp"
+
+// Randomized differential test of the ToChars engine against the Stream engine.
+// Random tables of numbers, with extreme values, random widths, precisions, arrangements,
+// number formats and render windows, have to render to the same bytes by both engines,
+// rendered_size has to give the exact size and no output may contain a NUL byte.
+// The ToChars engine renders every table with and without the value cache, tables of repeated
+// values, zeros of both signs and NaNs exercise its hits, the same bytes are required.
+// Standalone usage: plotter_differential_fuzz [iterations] [seed]
+// Built with PLOTTER_LIBFUZZER, the cases are driven by libFuzzer instead.
+
+namespace {
+
+    /**
+     * @brief Source of the random choices read from a libFuzzer input, zeros after its end.
+     */
+    class FuzzInput {
+
+        const std::uint8_t* _data;
+        std::size_t _size;
+
+    public:
+
+        FuzzInput(const std::uint8_t* data, std::size_t size) : _data(data), _size(size) {}
+
+        std::uint64_t next() {
+            std::uint64_t value = 0;
+            for (int i = 0; i < 8 && _size != 0; i++, _data++, _size--) {
+                value = value << 8 | *_data;
+            }
+            return value;
+        }
+
+        std::uint64_t below(std::uint64_t bound) {
+            return next() % bound;
+        }
+    };
+
+    /**
+     * @brief Returns a random value of T, often one of its extremes.
+     */
+    template <typename T, typename Source>
+    T make_value(Source& source) {
+        using limits = std::numeric_limits<T>;
+        std::uint64_t kind = source.below(16);
+        if constexpr (std::is_floating_point_v<T>) {
+            switch (kind) {
+                case 0: return limits::quiet_NaN();
+                case 1: return -limits::quiet_NaN();
+                case 2: return limits::infinity();
+                case 3: return -limits::infinity();
+                case 4: return static_cast<T>(-0.0);
+                case 5: return limits::denorm_min();
+                case 6: return limits::min();
+                case 7: return limits::max();
+                case 8: return limits::lowest();
+                case 9: return limits::epsilon();
+                default: {
+                    // any exponent of the type with a random mantissa
+                    T mantissa = static_cast<T>(source.next() >> 11) / static_cast<T>(1ull << 53);
+                    int exponent = static_cast<int>(source.below(limits::max_exponent - limits::min_exponent + limits::digits)) + limits::min_exponent - limits::digits;
+                    T value = std::ldexp(mantissa, exponent);
+                    return source.below(2) == 0 ? -value : value;
+                }
+            }
+        }
+        else {
+            switch (kind) {
+                case 0: return limits::min();
+                case 1: return limits::max();
+                case 2: return T(0);
+                case 3: return static_cast<T>(source.below(1000));
+                default: return static_cast<T>(source.next());
+            }
+        }
+    }
+
+    /**
+     * @brief Returns the values of a table, in about half of the tables drawn from a few repeated values.
+     */
+    template <typename T, typename Source>
+    std::vector<T> make_data(Source& source, std::size_t size) {
+        std::vector<T> data;
+        if (source.below(2) == 0) {
+            for (std::size_t i = 0; i < size; i++) {
+                data.push_back(make_value<T>(source));
+            }
+            return data;
+        }
+
+        std::vector<T> pool;
+        if constexpr (std::is_floating_point_v<T>) {
+            pool = { static_cast<T>(0.0), static_cast<T>(-0.0), std::numeric_limits<T>::quiet_NaN() };
+        }
+        for (std::size_t i = source.below(5); i > 0; i--) {
+            pool.push_back(make_value<T>(source));
+        }
+        if (pool.empty()) {
+            pool.push_back(make_value<T>(source));
+        }
+        // a share of fresh values lowers the hit rate, so the cache of a column may turn itself off
+        std::uint64_t fresh_share = source.below(4);
+        for (std::size_t i = 0; i < size; i++) {
+            data.push_back(source.below(4) < fresh_share ? make_value<T>(source) : pool[source.below(pool.size())]);
+        }
+        return data;
+    }
+
+    /**
+     * @brief Renders one random table of T by both engines and with and without the value cache and compares the results.
+     *
+     * @return The number of failed checks.
+     */
+    template <typename T, typename Source>
+    int run_case(Source& source, const char* type_name) {
+        std::size_t cols = 1 + source.below(6);
+        std::size_t size = 1 + source.below(source.below(32) == 0 ? 1500 : 40);
+        std::size_t table_width = 20 + source.below(781);
+        DataArrangement arrangement = source.below(2) == 0 ? DataArrangement::RowMajor : DataArrangement::ColumnMajor;
+
+        std::vector<T> data = make_data<T>(source, size);
+        std::vector<std::string> column_names;
+        for (std::size_t j = 0; j < cols; j++) {
+            column_names.push_back("c" + std::to_string(j));
+        }
+        Plotter<T> plotter(data.data(), "fuzz", column_names, table_width, size, arrangement);
+
+        std::string description = std::string(type_name) + " cols=" + std::to_string(cols) + " size=" + std::to_string(size)
+            + " width=" + std::to_string(table_width) + (arrangement == DataArrangement::RowMajor ? " row" : " col");
+        int failures = 0;
+
+        // a precision is accepted exactly when the fixed notation of the largest value fits the cell buffer
+        unsigned int precision = static_cast<unsigned int>(source.below(source.below(4) == 0 && size <= 40 ? 1024 : 40));
+        std::size_t integer_digits = 0;
+        if constexpr (std::is_floating_point_v<T>) {
+            integer_digits = std::min(std::numeric_limits<T>::max_exponent10, std::numeric_limits<double>::max_exponent10);
+        }
+        bool accepted = integer_digits + precision + 3 < 512;
+        try {
+            plotter.set_precision(precision);
+            if (!accepted) {
+                std::cerr << description << ": precision " << precision << " was accepted\n";
+                failures++;
+            }
+        }
+        catch (const std::invalid_argument&) {
+            if (accepted) {
+                std::cerr << description << ": precision " << precision << " was rejected\n";
+                failures++;
+            }
+        }
+        description += " precision=" + std::to_string(precision);
+
+        if (source.below(3) == 0) {
+            const char separators[] = { '\0', ',', '.', ' ', '\'' };
+            NumberFormat format{ source.below(2) == 0 ? '.' : ',', separators[source.below(5)] };
+            plotter.set_number_format(format);
+            description += std::string(" format='") + format.decimal_point + "','" + (format.thousands_separator == '\0' ? '0' : format.thousands_separator) + "'";
+        }
+
+        RenderOptions options;
+        options.first_row = source.below(4) == 0 ? source.below(10) : 0;
+        options.row_count = source.below(4) == 0 ? source.below(10) : static_cast<std::size_t>(-1);
+        options.paged_column_width = source.below(4) == 0 ? 1 + source.below(30) : 0;
+
+        // ToChars without and with the value cache, then Stream with a random cache setting
+        const char* render_names[] = { "ToChars", "ToChars with the value cache", "Stream" };
+        std::optional<std::string> outputs[3];
+        for (int e = 0; e < 3; e++) {
+            RenderOptions engine_options = options;
+            engine_options.engine = e == 2 ? CellEngine::Stream : CellEngine::ToChars;
+            engine_options.value_cache = e == 1 || (e == 2 && source.below(2) == 0);
+            try {
+                std::string out = plotter.get_table(engine_options);
+                std::size_t expected = plotter.rendered_size(engine_options);
+                if (expected != out.size()) {
+                    std::cerr << description << ": " << render_names[e] << " rendered_size " << expected << " differs from the output size " << out.size() << "\n";
+                    failures++;
+                }
+                if (out.find('\0') != std::string::npos) {
+                    std::cerr << description << ": " << render_names[e] << " output contains a NUL byte\n";
+                    failures++;
+                }
+                outputs[e] = std::move(out);
+            }
+            catch (const std::length_error&) {
+                // the layout does not fit the width, both engines have to reject it
+            }
+        }
+        for (int e = 1; e < 3; e++) {
+            if (outputs[e] != outputs[0]) {
+                std::cerr << description << ": " << render_names[e] << " output differs from ToChars\n";
+                failures++;
+            }
+        }
+        return failures;
+    }
+
+    /**
+     * @brief Runs one case of a type chosen by the source.
+     */
+    template <typename Source>
+    int run_random_case(Source& source) {
+        switch (source.below(12)) {
+            case 0: return run_case<int>(source, "int");
+            case 1: return run_case<long>(source, "long");
+            case 2: return run_case<long long>(source, "long long");
+            case 3: return run_case<unsigned int>(source, "unsigned int");
+            case 4: return run_case<unsigned long>(source, "unsigned long");
+            case 5: return run_case<unsigned long long>(source, "unsigned long long");
+            case 6: return run_case<std::int8_t>(source, "int8_t");
+            case 7: return run_case<std::uint8_t>(source, "uint8_t");
+            case 8: return run_case<short>(source, "short");
+            case 9: return run_case<float>(source, "float");
+            case 10: return run_case<long double>(source, "long double");
+            default: return run_case<double>(source, "double");
+        }
+    }
+}
+
+#if defined(PLOTTER_LIBFUZZER)
+
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* data, std::size_t size) {
+    FuzzInput source(data, size);
+    if (run_random_case(source) != 0) {
+        std::abort();
+    }
+    return 0;
+}
+
+#else
+
+int main(int argc, char** argv) {
+    std::size_t iterations = argc > 1 ? std::stoull(argv[1]) : 3000;
+    std::uint64_t seed = argc > 2 ? std::stoull(argv[2]) : 1;
+    plotter_tests::Lcg source(seed);
+
+    std::size_t failed_cases = 0;
+    for (std::size_t i = 0; i < iterations; i++) {
+        if (run_random_case(source) != 0) {
+            failed_cases++;
+        }
+    }
+    std::cout << iterations << " cases, " << failed_cases << " failed\n";
+    return failed_cases == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+#endif
@@ -0,0 +1,90 @@
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "corpus.hpp"
+
+// Renders every table of the corpus and compares it byte for byte with its golden file.
+// The Stream engine has to give the same bytes and rendered_size the exact length.
+// A paged table, whose last page has fewer columns, is compared the same way.
+// Usage: plotter_golden <golden directory> [--update]
+
+namespace {
+
+    constexpr std::size_t golden_rows = 41;
+
+    std::string read_file(const std::filesystem::path& path) {
+        std::ifstream file(path, std::ios::binary);
+        std::ostringstream content;
+        content << file.rdbuf();
+        return content.str();
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "usage: plotter_golden <golden directory> [--update]\n";
+        return EXIT_FAILURE;
+    }
+    std::filesystem::path directory = argv[1];
+    bool update = argc > 2 && std::string(argv[2]) == "--update";
+    int failures = 0;
+    int tables = 0;
+
+    auto compare = [&](const std::string& name, const auto& plotter, const RenderOptions& options) {
+        std::filesystem::path path = directory / (name + ".txt");
+        std::string rendered = plotter.get_table(options);
+        tables++;
+
+        if (update) {
+            std::ofstream(path, std::ios::binary) << rendered;
+            return;
+        }
+        if (!std::filesystem::exists(path)) {
+            std::cerr << name << ": missing golden file " << path << "\n";
+            failures++;
+            return;
+        }
+        std::string golden = read_file(path);
+        if (rendered != golden) {
+            std::size_t position = 0;
+            while (position < rendered.size() && position < golden.size() && rendered[position] == golden[position]) {
+                position++;
+            }
+            std::cerr << name << ": output differs from the golden file at byte " << position << "\n";
+            failures++;
+        }
+        RenderOptions stream = options;
+        stream.engine = CellEngine::Stream;
+        if (plotter.get_table(stream) != rendered) {
+            std::cerr << name << ": Stream engine output differs from ToChars\n";
+            failures++;
+        }
+        if (plotter.rendered_size(options) != rendered.size()) {
+            std::cerr << name << ": rendered_size " << plotter.rendered_size(options) << " differs from the output size " << rendered.size() << "\n";
+            failures++;
+        }
+    };
+
+    plotter_tests::for_each_table(golden_rows, [&](auto& table) {
+        compare(table.name, table.plotter(), {});
+    });
+
+    // two pages of two columns and a last page of one, every page is framed at the width of its rows
+    std::vector<int> paged_data(15);
+    for (std::size_t i = 0; i < paged_data.size(); i++) {
+        paged_data[i] = static_cast<int>(i * i) - 40;
+    }
+    Plotter<int> paged(paged_data.data(), "paged", { "a", "b", "c", "d", "e" }, 100, paged_data.size(), DataArrangement::RowMajor);
+    compare("paged_last_page", paged, { .paged_column_width = 40 });
+
+    if (update) {
+        std::cout << "updated " << tables << " golden files in " << directory << "\n";
+        return EXIT_SUCCESS;
+    }
+    std::cout << tables << " tables, " << failures << " failures\n";
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,141 @@
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "Plotter.hpp"
+
+// Maps a sparse file of more than 2^32 one-byte elements and renders row windows
+// near 2^31 and near the end of the table in both arrangements. Every cell has to show
+// the value at row * cols + column for RowMajor and at row + column * rows for ColumnMajor,
+// so no index is truncated to 32 bits. Exits with 77 (skipped) where the file cannot be mapped.
+
+namespace {
+
+    constexpr int skipped = 77;
+    constexpr std::size_t cols = 2;
+    constexpr std::uint64_t size = (std::uint64_t(1) << 33) + 7;
+    constexpr std::size_t rows = (size + cols - 1) / cols;
+    constexpr std::size_t window_rows = 6;
+
+    /**
+     * @brief Marker written at an index, it is never zero, so an unwritten cell cannot match it.
+     */
+    std::uint8_t marker(std::uint64_t index) {
+        return static_cast<std::uint8_t>(index % 251 + 1);
+    }
+
+    std::uint64_t cell_index(DataArrangement arrangement, std::size_t row, std::size_t column) {
+        return arrangement == DataArrangement::RowMajor ? std::uint64_t(row) * cols + column : row + std::uint64_t(column) * rows;
+    }
+
+    /**
+     * @brief Returns the cells of the data rows of a rendered table, a blank cell is empty.
+     */
+    std::vector<std::vector<std::string>> parse_rows(const std::string& table) {
+        std::vector<std::vector<std::string>> parsed;
+        std::istringstream lines(table);
+        for (std::string line; std::getline(lines, line);) {
+            // the data rows are the only lines of digits between bars
+            if (line.empty() || line[0] != '|' || line.find_first_not_of("| 0123456789") != std::string::npos) {
+                continue;
+            }
+            std::vector<std::string> cells;
+            std::istringstream row(line.substr(1));
+            for (std::string cell; std::getline(row, cell, '|');) {
+                cells.push_back(cell.substr(std::min(cell.find_first_not_of(' '), cell.size())));
+            }
+            parsed.push_back(cells);
+        }
+        return parsed;
+    }
+}
+
+int main() {
+    if constexpr (sizeof(std::size_t) < 8) {
+        std::cout << "skipped, size_t has 32 bits\n";
+        return skipped;
+    }
+
+    std::filesystem::path path = std::filesystem::temp_directory_path() / ("plotter_large_index_" + std::to_string(getpid()));
+    int file = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+    if (file < 0) {
+        std::cout << "skipped, cannot create " << path << "\n";
+        return skipped;
+    }
+    unlink(path.c_str());
+    if (ftruncate(file, static_cast<off_t>(size)) != 0) {
+        std::cout << "skipped, the file system cannot hold a sparse file of " << size << " bytes\n";
+        close(file);
+        return skipped;
+    }
+
+    const std::size_t first_rows[] = { (std::size_t(1) << 31) - window_rows / 2, rows - window_rows };
+    const DataArrangement arrangements[] = { DataArrangement::RowMajor, DataArrangement::ColumnMajor };
+
+    // only the cells of the windows are written, the rest of the file stays a hole
+    for (DataArrangement arrangement : arrangements) {
+        for (std::size_t first_row : first_rows) {
+            for (std::size_t i = first_row; i < first_row + window_rows; i++) {
+                for (std::size_t j = 0; j < cols; j++) {
+                    std::uint64_t index = cell_index(arrangement, i, j);
+                    std::uint8_t value = marker(index);
+                    if (index < size && pwrite(file, &value, 1, static_cast<off_t>(index)) != 1) {
+                        std::cout << "skipped, cannot write the markers\n";
+                        close(file);
+                        return skipped;
+                    }
+                }
+            }
+        }
+    }
+
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, file, 0);
+    close(file);
+    if (mapping == MAP_FAILED) {
+        std::cout << "skipped, cannot map " << size << " bytes\n";
+        return skipped;
+    }
+    // the table only reads its data
+    std::uint8_t* data = static_cast<std::uint8_t*>(mapping);
+
+    int failures = 0;
+    for (DataArrangement arrangement : arrangements) {
+        const char* arrangement_name = arrangement == DataArrangement::RowMajor ? "RowMajor" : "ColumnMajor";
+        Plotter<std::uint8_t> plotter(data, "large", { "a", "b" }, 40, size, arrangement);
+
+        for (std::size_t first_row : first_rows) {
+            std::string table = plotter.get_table({ .first_row = first_row, .row_count = window_rows });
+            std::vector<std::vector<std::string>> parsed = parse_rows(table);
+            if (parsed.size() != window_rows) {
+                std::cerr << arrangement_name << " rows from " << first_row << ": " << parsed.size() << " rows rendered instead of " << window_rows << "\n";
+                failures++;
+                continue;
+            }
+            if (plotter.rendered_size({ .first_row = first_row, .row_count = window_rows }) != table.size()) {
+                std::cerr << arrangement_name << " rows from " << first_row << ": rendered_size differs from the output size\n";
+                failures++;
+            }
+            for (std::size_t i = 0; i < window_rows; i++) {
+                for (std::size_t j = 0; j < cols; j++) {
+                    std::uint64_t index = cell_index(arrangement, first_row + i, j);
+                    std::string expected = index < size ? std::to_string(marker(index)) : "";
+                    std::string shown = j < parsed[i].size() ? parsed[i][j] : "";
+                    if (shown != expected) {
+                        std::cerr << arrangement_name << " row " << first_row + i << " column " << j << " (index " << index << "): shows '" << shown << "' instead of '" << expected << "'\n";
+                        failures++;
+                    }
+                }
+            }
+        }
+    }
+
+    munmap(mapping, size);
+    std::cout << "rows " << rows << ", " << failures << " failures\n";
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
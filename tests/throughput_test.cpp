@@ -0,0 +1,107 @@
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include "corpus.hpp"
+
+// Measures the throughput of rendering the whole corpus relative to a fixed reference workload.
+// Every table is rendered alternately with the reference, a plain loop writing the cell indices
+// into a string, and the best of several runs of both is kept. Their ratio does not depend on
+// the speed of the machine at the moment, so it is comparable between runs and machines.
+// The test fails when the relative throughput drops below the committed baseline by more than
+// the tolerance, --update writes the measured ratio as the new baseline. Only optimized builds
+// are compared, as the ratio of unoptimized code says nothing about the release, others are skipped.
+// Usage: plotter_throughput <baseline file> [tolerance | --update]
+
+namespace {
+
+    constexpr std::size_t throughput_rows = 2000;
+    constexpr int throughput_runs = 9;
+    constexpr int skipped = 77;
+
+    /**
+     * @brief Writes every cell index and a separator into out, the work of a trivial table.
+     */
+    void reference_render(std::size_t cells, std::string& out) {
+        out.clear();
+        std::array<char, 24> buffer;
+        for (std::size_t i = 0; i < cells; i++) {
+            out.append(buffer.data(), std::to_chars(buffer.data(), buffer.data() + buffer.size(), i).ptr);
+            out += '|';
+        }
+    }
+
+    template <typename Function>
+    double time_seconds(Function&& function) {
+        auto start = std::chrono::steady_clock::now();
+        function();
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "usage: plotter_throughput <baseline file> [tolerance | --update]\n";
+        return EXIT_FAILURE;
+    }
+    std::string baseline_path = argv[1];
+    bool update = argc > 2 && std::string(argv[2]) == "--update";
+    double tolerance = argc > 2 && !update ? std::stod(argv[2]) : 0.3;
+
+    double seconds = 0.0;
+    double reference_seconds = 0.0;
+    std::size_t cells = 0;
+    std::size_t bytes = 0;
+    std::size_t reference_bytes = 0;
+    plotter_tests::for_each_table(throughput_rows, [&](auto& table) {
+        auto plotter = table.plotter();
+        std::string out;
+        std::string reference;
+        double best = 0.0;
+        double best_reference = 0.0;
+        for (int run = 0; run < throughput_runs; run++) {
+            double elapsed = time_seconds([&] { out = plotter.get_table(); });
+            double reference_elapsed = time_seconds([&] { reference_render(table.data.size(), reference); });
+            best = run == 0 ? elapsed : std::min(best, elapsed);
+            best_reference = run == 0 ? reference_elapsed : std::min(best_reference, reference_elapsed);
+        }
+        seconds += best;
+        reference_seconds += best_reference;
+        cells += table.data.size();
+        bytes += out.size();
+        reference_bytes += reference.size();
+    });
+
+    double relative = reference_seconds / seconds;
+    std::cout << cells << " cells, " << bytes << " bytes in " << seconds * 1e3 << " ms, " << static_cast<double>(cells) / seconds / 1e6
+        << " Mcells/s, " << relative << " of the reference throughput (" << reference_bytes << " bytes in " << reference_seconds * 1e3 << " ms)\n";
+
+    if (update) {
+        std::ofstream(baseline_path) << relative << "\n";
+        std::cout << "recorded baseline " << relative << " in " << baseline_path << "\n";
+        return EXIT_SUCCESS;
+    }
+    if (!PLOTTER_OPTIMIZED_BUILD) {
+        std::cout << "skipped, the baseline is compared in optimized builds only\n";
+        return skipped;
+    }
+
+    std::ifstream baseline_file(baseline_path);
+    double baseline = 0.0;
+    if (!(baseline_file >> baseline) || baseline <= 0.0) {
+        std::cerr << "no baseline in " << baseline_path << ", record one with --update\n";
+        return EXIT_FAILURE;
+    }
+
+    double threshold = baseline * (1.0 - tolerance);
+    std::cout << "baseline " << baseline << ", threshold " << threshold << "\n";
+    if (relative < threshold) {
+        std::cerr << "relative throughput dropped by " << (1.0 - relative / baseline) * 100.0 << "% against the baseline\n";
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
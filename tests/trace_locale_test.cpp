@@ -0,0 +1,67 @@
+#include <cstdlib>
+#include <iostream>
+#include <locale>
+#include <numeric>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "Plotter.hpp"
+
+// RenderTrace::write_json has to produce valid JSON numbers whatever locale the stream
+// or the program uses, the output under a locale with grouping has to equal the classic one.
+
+namespace {
+
+    /**
+     * @brief Numeric punctuation which groups thousands by '\'' and uses ',' as the decimal point.
+     */
+    struct GroupingPunct : std::numpunct<char> {
+        char do_decimal_point() const override { return ','; }
+        char do_thousands_sep() const override { return '\''; }
+        std::string do_grouping() const override { return "\3"; }
+    };
+}
+
+int main() {
+    std::vector<int> data(5000 * 4);
+    std::iota(data.begin(), data.end(), 0);
+    Plotter<int> plotter(data.data(), "trace", { "a", "b", "c", "d" }, 60, data.size(), DataArrangement::RowMajor);
+
+    RenderTrace trace;
+    plotter.get_table({ .trace = &trace });
+
+    std::ostringstream classic;
+    trace.write_json(classic);
+
+    std::locale grouping(std::locale::classic(), new GroupingPunct);
+    std::locale previous = std::locale::global(grouping);
+    std::ostringstream imbued;
+    imbued.imbue(grouping);
+    trace.write_json(imbued);
+    std::locale::global(previous);
+
+    int failures = 0;
+    if (imbued.str() != classic.str()) {
+        std::cerr << "write_json output depends on the locale\n";
+        failures++;
+    }
+
+    // the row ranges are above a thousand, so a grouped number would show a separator
+    const std::string& json = classic.str();
+    if (!std::regex_search(json, std::regex("\"count\":[0-9]{4,}[,}]"))) {
+        std::cerr << "the trace has no row range above a thousand\n";
+        failures++;
+    }
+    std::regex value("\"(?:tid|ts|dur|first|count)\":([^,}]*)");
+    std::regex number("-?[0-9]+(\\.[0-9]+)?");
+    for (std::sregex_iterator it(json.begin(), json.end(), value), end; it != end; ++it) {
+        if (!std::regex_match((*it)[1].str(), number)) {
+            std::cerr << "not a JSON number: " << (*it)[0] << "\n";
+            failures++;
+        }
+    }
+
+    std::cout << trace.size() << " events, " << failures << " failures\n";
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
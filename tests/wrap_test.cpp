@@ -0,0 +1,99 @@
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "Plotter.hpp"
+
+// Word-wrapped string cells compared with fixed output: a break exactly at the column width,
+// runs of whitespace, whitespace-only cells and a word longer than the column, in both arrangements.
+// rendered_size, render_into and write_file have to agree with get_table.
+
+namespace {
+
+    int failures = 0;
+
+    void check(bool condition, const std::string& message) {
+        if (!condition) {
+            std::cerr << message << "\n";
+            failures++;
+        }
+    }
+
+    std::string read_file(const std::filesystem::path& path) {
+        std::ifstream file(path, std::ios::binary);
+        std::ostringstream content;
+        content << file.rdbuf();
+        return content.str();
+    }
+
+    // the cells are 4 characters wide
+    std::vector<std::string> cells = { "abcd efgh", "ab    cd", "      ", "abcdefghij", "x", "", "last one" };
+
+    const std::string row_major =
+        "\n"
+        "+--------------+\n"
+        "|     wrap     |\n"
+        "+--------------+\n"
+        "| a  | b  | c  |\n"
+        "+--------------+\n"
+        "|abcd|  ab|    |\n"
+        "|efgh|  cd|    |\n"
+        "|abcd|   x|    |\n"
+        "|efgh|    |    |\n"
+        "|  ij|    |    |\n"
+        "|last|    |    |\n"
+        "| one|    |    |\n"
+        "+--------------+\n"
+        "\n";
+
+    const std::string column_major =
+        "\n"
+        "+--------------+\n"
+        "|     wrap     |\n"
+        "+--------------+\n"
+        "| a  | b  | c  |\n"
+        "+--------------+\n"
+        "|abcd|abcd|last|\n"
+        "|efgh|efgh| one|\n"
+        "|    |  ij|    |\n"
+        "|  ab|   x|    |\n"
+        "|  cd|    |    |\n"
+        "|    |    |    |\n"
+        "+--------------+\n"
+        "\n";
+
+    /**
+     * @brief Renders the cells wrapped by every output of the Plotter and compares them with the expected table.
+     */
+    void check_arrangement(const std::string& name, DataArrangement arrangement, const std::string& expected) {
+        Plotter<std::string> plotter(cells.data(), "wrap", { "a", "b", "c" }, 16, cells.size(), arrangement);
+        const RenderOptions options{ .wrap_cells = true };
+
+        std::string table = plotter.get_table(options);
+        check(table == expected, name + ": get_table differs from the expected output\n" + table);
+        check(plotter.get_table({ .engine = CellEngine::Stream, .wrap_cells = true }) == table, name + ": the Stream engine differs from ToChars");
+        check(plotter.rendered_size(options) == table.size(), name + ": rendered_size differs from the output size");
+
+        std::vector<char> destination(table.size());
+        RenderResult result = plotter.render_into(destination, options);
+        check(result.fits() && std::string(destination.begin(), destination.end()) == table, name + ": render_into differs from get_table");
+
+        std::filesystem::path path = std::filesystem::temp_directory_path() / "plotter_wrap_test.txt";
+        for (unsigned int threads : { 1u, 3u }) {
+            plotter.write_file(path.string(), threads, options);
+            check(read_file(path) == table, name + ": write_file with " + std::to_string(threads) + " threads differs from get_table");
+        }
+        std::filesystem::remove(path);
+    }
+}
+
+int main() {
+    check_arrangement("RowMajor", DataArrangement::RowMajor, row_major);
+    check_arrangement("ColumnMajor", DataArrangement::ColumnMajor, column_major);
+
+    std::cout << failures << " failures\n";
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}